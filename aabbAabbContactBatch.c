@@ -0,0 +1,46 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+size_t aabbAabbContactBatch(contactSoA out, aabbSoA a, aabbSoA b, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  const v4f zero = v4fSplat(0.0f), one = v4fSplat(1.0f), half = v4fSplat(0.5f);
+
+  size_t n, k, touching = 0;
+
+  for(n = 0; n < count; n += 4)
+  {
+    size_t lanes = count - n < 4 ? count - n : 4;
+
+    v4f3 amin = v4f3LoadN(a.min, n, lanes), amax = v4f3LoadN(a.max, n, lanes);
+    v4f3 bmin = v4f3LoadN(b.min, n, lanes), bmax = v4f3LoadN(b.max, n, lanes);
+
+    /* overlap interval per axis */
+    v4f3 lo = { v4fMax(amin.x, bmin.x), v4fMax(amin.y, bmin.y), v4fMax(amin.z, bmin.z) };
+    v4f3 hi = { v4fMin(amax.x, bmax.x), v4fMin(amax.y, bmax.y), v4fMin(amax.z, bmax.z) };
+    v4f3 o  = v4f3Subtract(hi, lo);
+
+    /* separate along the axis of least overlap, towards b's center */
+    v4f3 centers = v4f3Subtract(v4f3Add(bmin, bmax), v4f3Add(amin, amax));
+    v4f  depth   = o.x;
+    v4f3 normal  = { v4fSelect(centers.x < zero, -one, one), zero, zero };
+    v4i  m;
+
+    m = o.y < depth; depth = v4fSelect(m, o.y, depth);
+    normal = v4f3Select(m, (v4f3){ zero, v4fSelect(centers.y < zero, -one, one), zero }, normal);
+
+    m = o.z < depth; depth = v4fSelect(m, o.z, depth);
+    normal = v4f3Select(m, (v4f3){ zero, zero, v4fSelect(centers.z < zero, -one, one) }, normal);
+
+    v4f3StoreN(out.normal, n, normal, lanes);
+    v4f3StoreN(out.point, n, v4f3Scale(v4f3Add(lo, hi), half), lanes);
+    v4fStoreN(out.depth + n, depth, lanes);
+
+    for(k = 0; k < lanes; ++k)
+      touching += depth[k] >= 0.0f;
+  }
+
+  return touching;
+}
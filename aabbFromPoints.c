@@ -0,0 +1,49 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void aabbFromPoints(aabb *box, const vec3f *points, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  /* treat the points as a flat float array; four points fill twelve lanes
+   * so that every lane always sees the same component
+   */
+  const float *p = &points->x;
+  float       lo[12], hi[12];
+  size_t      i, n = count / 4;
+  int         k;
+
+  for(k = 0; k < 12; ++k)
+  {
+    lo[k] =  INFINITY;
+    hi[k] = -INFINITY;
+  }
+
+  for(i = 0; i < n; ++i, p += 12)
+  {
+    for(k = 0; k < 12; ++k)
+    {
+      lo[k] = p[k] < lo[k] ? p[k] : lo[k];
+      hi[k] = p[k] > hi[k] ? p[k] : hi[k];
+    }
+  }
+
+  for(i = n*4; i < count; ++i, p += 3)
+  {
+    for(k = 0; k < 3; ++k)
+    {
+      lo[k] = p[k] < lo[k] ? p[k] : lo[k];
+      hi[k] = p[k] > hi[k] ? p[k] : hi[k];
+    }
+  }
+
+  for(k = 3; k < 12; ++k)
+  {
+    lo[k%3] = lo[k] < lo[k%3] ? lo[k] : lo[k%3];
+    hi[k%3] = hi[k] > hi[k%3] ? hi[k] : hi[k%3];
+  }
+
+  box->min = (vec3f){ lo[0], lo[1], lo[2] };
+  box->max = (vec3f){ hi[0], hi[1], hi[2] };
+}
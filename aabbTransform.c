@@ -0,0 +1,30 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void aabbTransform(aabb *out, const aabb *in, const mtx44 *m)
+{
+  PROFILE_FUNCTION();
+
+  const float *lo = &in->min.x;
+  const float *hi = &in->max.x;
+  float       rlo[3], rhi[3];
+  int         i, j;
+
+  for(j = 0; j < 3; ++j)
+    rlo[j] = rhi[j] = m->v[3*4+j];
+
+  for(i = 0; i < 3; ++i)
+  {
+    for(j = 0; j < 3; ++j)
+    {
+      float a = m->v[i*4+j]*lo[i];
+      float b = m->v[i*4+j]*hi[i];
+
+      rlo[j] += a < b ? a : b;
+      rhi[j] += a < b ? b : a;
+    }
+  }
+
+  out->min = (vec3f){ rlo[0], rlo[1], rlo[2] };
+  out->max = (vec3f){ rhi[0], rhi[1], rhi[2] };
+}
@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void aabbTransformBatch(aabb *out, const aabb *in, const mtx44 *m, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+
+  for(i = 0; i < count; ++i)
+    aabbTransform(&out[i], &in[i], &m[i]);
+}
@@ -0,0 +1,16 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void* arenaAlloc(arena *a, size_t size, size_t align)
+{
+  PROFILE_FUNCTION();
+
+  size_t offset = (a->used + align - 1) & ~(align - 1);
+
+  if(offset > a->size || size > a->size - offset)
+    return NULL;
+
+  a->used = offset + size;
+
+  return a->base + offset;
+}
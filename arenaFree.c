@@ -0,0 +1,14 @@
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void arenaFree(arena *a)
+{
+  PROFILE_FUNCTION();
+
+  free(a->base);
+
+  a->base = NULL;
+  a->size = 0;
+  a->used = 0;
+}
@@ -0,0 +1,22 @@
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int arenaInit(arena *a, size_t size)
+{
+  PROFILE_FUNCTION();
+
+  void *base = NULL;
+
+  /* round up so the whole block is made of cache lines */
+  size = (size + 63) & ~(size_t)63;
+
+  if(size && posix_memalign(&base, 64, size) != 0)
+    base = NULL;
+
+  a->base = base;
+  a->size = base ? size : 0;
+  a->used = 0;
+
+  return base != NULL || size == 0;
+}
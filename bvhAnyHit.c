@@ -0,0 +1,73 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#define STACK_SIZE 256
+
+int bvhAnyHit(const bvh *b, const ray *r, const vec3f *vertices, float tmax)
+{
+  PROFILE_FUNCTION();
+
+  s32   stack[STACK_SIZE];
+  int   sp = 0;
+  vec3f o   = r->origin;
+  vec3f inv = { 1.0f / r->direction.x, 1.0f / r->direction.y, 1.0f / r->direction.z };
+
+  if(b->nodeCount == 0)
+    return 0;
+
+  stack[sp++] = 0;
+
+  while(sp > 0)
+  {
+    const bvhNode *node = &b->nodes[stack[--sp]];
+    int           hit[4];
+    int           k;
+
+    for(k = 0; k < 4; ++k)
+    {
+      float x1 = (node->minx[k] - o.x) * inv.x, x2 = (node->maxx[k] - o.x) * inv.x;
+      float y1 = (node->miny[k] - o.y) * inv.y, y2 = (node->maxy[k] - o.y) * inv.y;
+      float z1 = (node->minz[k] - o.z) * inv.z, z2 = (node->maxz[k] - o.z) * inv.z;
+
+      float nx = x1 < x2 ? x1 : x2, fx = x1 < x2 ? x2 : x1;
+      float ny = y1 < y2 ? y1 : y2, fy = y1 < y2 ? y2 : y1;
+      float nz = z1 < z2 ? z1 : z2, fz = z1 < z2 ? z2 : z1;
+
+      float tn = nx > 0.0f ? nx : 0.0f;
+      float tf = fx;
+
+      tn = ny > tn ? ny : tn;
+      tn = nz > tn ? nz : tn;
+      tf = fy < tf ? fy : tf;
+      tf = fz < tf ? fz : tf;
+
+      hit[k] = (tn <= tf) & (tn < tmax);
+    }
+
+    for(k = 0; k < 4; ++k)
+    {
+      s32 j;
+
+      if(node->child[k] < 0 || !hit[k])
+        continue;
+
+      if(node->count[k] == 0)
+      {
+        stack[sp++] = node->child[k];
+        continue;
+      }
+
+      for(j = node->child[k]; j < node->child[k] + node->count[k]; ++j)
+      {
+        s32   p = b->prims[j];
+        float ht;
+
+        if(rayTriangle(r, vertices[p*3+0], vertices[p*3+1], vertices[p*3+2], &ht, NULL, NULL)
+        && ht < tmax)
+          return 1;
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,334 @@
+#include <math.h>
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#define BINS      12 /* SAH bins per axis */
+#define LEAF_SIZE 4  /* maximum primitives per leaf */
+#define SAH_DEPTH 32 /* node depth after which splits fall back to the median */
+
+typedef struct
+{
+  const aabb *boxes;
+  vec3f      *centroids;
+  s32        *prims;
+  bvhNode    *nodes;
+  size_t      nodeCount;
+} context;
+
+static inline float
+component(vec3f v, int axis)
+{
+  return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+}
+
+static inline void
+grow(aabb *b, vec3f lo, vec3f hi)
+{
+  b->min.x = lo.x < b->min.x ? lo.x : b->min.x;
+  b->min.y = lo.y < b->min.y ? lo.y : b->min.y;
+  b->min.z = lo.z < b->min.z ? lo.z : b->min.z;
+  b->max.x = hi.x > b->max.x ? hi.x : b->max.x;
+  b->max.y = hi.y > b->max.y ? hi.y : b->max.y;
+  b->max.z = hi.z > b->max.z ? hi.z : b->max.z;
+}
+
+static inline float
+area(const aabb *b)
+{
+  vec3f d = vec3fSubtract(b->max, b->min);
+
+  if(d.x < 0.0f || d.y < 0.0f || d.z < 0.0f)
+    return 0.0f;
+
+  return d.x*d.y + d.y*d.z + d.z*d.x;
+}
+
+static const aabb empty = { {  INFINITY,  INFINITY,  INFINITY },
+                            { -INFINITY, -INFINITY, -INFINITY } };
+
+static aabb
+rangeBounds(const context *ctx, size_t first, size_t count)
+{
+  aabb   b = empty;
+  size_t i;
+
+  for(i = first; i < first + count; ++i)
+    grow(&b, ctx->boxes[ctx->prims[i]].min, ctx->boxes[ctx->prims[i]].max);
+
+  return b;
+}
+
+static inline int
+bin(float c, float lo, float scale)
+{
+  int b = (int)((c - lo) * scale);
+  return b < BINS-1 ? b : BINS-1;
+}
+
+/* reorder a range so the element at first+k has the k-th smallest centroid
+ * on an axis, with nothing larger before it and nothing smaller after it
+ * (quickselect)
+ */
+static void
+nthElement(context *ctx, size_t first, size_t count, size_t k, int axis)
+{
+  s32      *p  = ctx->prims + first;
+  ptrdiff_t lo = 0, hi = (ptrdiff_t)count - 1, n = (ptrdiff_t)k;
+
+  while(lo < hi)
+  {
+    float     pivot = component(ctx->centroids[p[lo + (hi - lo) / 2]], axis);
+    ptrdiff_t i = lo, j = hi;
+
+    while(i <= j)
+    {
+      while(component(ctx->centroids[p[i]], axis) < pivot)
+        ++i;
+      while(component(ctx->centroids[p[j]], axis) > pivot)
+        --j;
+
+      if(i <= j)
+      {
+        s32 tmp = p[i];
+        p[i++] = p[j];
+        p[j--] = tmp;
+      }
+    }
+
+    /* [lo, j] <= pivot <= [i, hi]; anything in between equals the pivot */
+    if(n <= j)
+      hi = j;
+    else if(n >= i)
+      lo = i;
+    else
+      break;
+  }
+}
+
+/* partition a range and return the size of the left side, which is always
+ * in [1, count-1]
+ */
+static size_t
+split(context *ctx, size_t first, size_t count, int sah)
+{
+  aabb   cb = empty;
+  float  bestCost = INFINITY;
+  int    bestAxis = -1, bestBin = 0;
+  size_t i, j;
+  int    axis, k;
+
+  for(i = first; i < first + count; ++i)
+    grow(&cb, ctx->centroids[ctx->prims[i]], ctx->centroids[ctx->prims[i]]);
+
+  for(axis = 0; sah && axis < 3; ++axis)
+  {
+    aabb   bounds[BINS], acc;
+    size_t n[BINS], accN;
+    float  leftArea[BINS];
+    size_t leftN[BINS];
+    float  lo     = component(cb.min, axis);
+    float  extent = component(cb.max, axis) - lo;
+    float  scale;
+
+    if(!(extent > 0.0f))
+      continue;
+
+    scale = BINS / extent;
+
+    for(k = 0; k < BINS; ++k)
+    {
+      bounds[k] = empty;
+      n[k]      = 0;
+    }
+
+    for(i = first; i < first + count; ++i)
+    {
+      s32 p = ctx->prims[i];
+
+      k = bin(component(ctx->centroids[p], axis), lo, scale);
+      grow(&bounds[k], ctx->boxes[p].min, ctx->boxes[p].max);
+      ++n[k];
+    }
+
+    acc  = empty;
+    accN = 0;
+    for(k = 0; k < BINS-1; ++k)
+    {
+      grow(&acc, bounds[k].min, bounds[k].max);
+      accN       += n[k];
+      leftArea[k] = area(&acc);
+      leftN[k]    = accN;
+    }
+
+    acc  = empty;
+    accN = 0;
+    for(k = BINS-1; k > 0; --k)
+    {
+      float cost;
+
+      grow(&acc, bounds[k].min, bounds[k].max);
+      accN += n[k];
+
+      if(leftN[k-1] == 0 || accN == 0)
+        continue;
+
+      cost = leftArea[k-1]*leftN[k-1] + area(&acc)*accN;
+      if(cost < bestCost)
+      {
+        bestCost = cost;
+        bestAxis = axis;
+        bestBin  = k-1;
+      }
+    }
+  }
+
+  if(bestAxis < 0)
+  {
+    /* median split on the longest centroid axis */
+    vec3f d = vec3fSubtract(cb.max, cb.min);
+
+    axis = d.x >= d.y && d.x >= d.z ? 0 : d.y >= d.z ? 1 : 2;
+    if(component(d, axis) > 0.0f)
+      nthElement(ctx, first, count, count / 2, axis);
+
+    return count / 2;
+  }
+
+  {
+    float lo    = component(cb.min, bestAxis);
+    float scale = BINS / (component(cb.max, bestAxis) - lo);
+
+    i = first;
+    j = first + count;
+    while(i < j)
+    {
+      if(bin(component(ctx->centroids[ctx->prims[i]], bestAxis), lo, scale) <= bestBin)
+        ++i;
+      else
+      {
+        s32 tmp = ctx->prims[i];
+        ctx->prims[i]   = ctx->prims[--j];
+        ctx->prims[j]   = tmp;
+      }
+    }
+  }
+
+  return i - first;
+}
+
+static s32
+build(context *ctx, size_t first, size_t count, int depth)
+{
+  s32    index = (s32)ctx->nodeCount++;
+  size_t rf[4], rc[4];
+  aabb   rb[4];
+  int    n = 1, k;
+
+  rf[0] = first;
+  rc[0] = count;
+  rb[0] = rangeBounds(ctx, first, count);
+
+  /* keep splitting the largest range until there are four children */
+  while(n < 4)
+  {
+    int    best = -1;
+    float  bestArea = -1.0f;
+    size_t left;
+
+    for(k = 0; k < n; ++k)
+    {
+      if(rc[k] > LEAF_SIZE && area(&rb[k]) > bestArea)
+      {
+        best     = k;
+        bestArea = area(&rb[k]);
+      }
+    }
+
+    if(best < 0)
+      break;
+
+    left      = split(ctx, rf[best], rc[best], depth < SAH_DEPTH);
+    rf[n]     = rf[best] + left;
+    rc[n]     = rc[best] - left;
+    rc[best]  = left;
+    rb[best]  = rangeBounds(ctx, rf[best], rc[best]);
+    rb[n]     = rangeBounds(ctx, rf[n], rc[n]);
+    ++n;
+  }
+
+  for(k = 0; k < 4; ++k)
+  {
+    aabb b = k < n ? rb[k] : empty;
+    s32  child, leaf;
+
+    if(k >= n || rc[k] == 0)
+    {
+      child = -1;
+      leaf  = 0;
+    }
+    else if(rc[k] <= LEAF_SIZE)
+    {
+      child = (s32)rf[k];
+      leaf  = (s32)rc[k];
+    }
+    else
+    {
+      child = build(ctx, rf[k], rc[k], depth + 1);
+      leaf  = 0;
+    }
+
+    ctx->nodes[index].minx[k]  = b.min.x;
+    ctx->nodes[index].miny[k]  = b.min.y;
+    ctx->nodes[index].minz[k]  = b.min.z;
+    ctx->nodes[index].maxx[k]  = b.max.x;
+    ctx->nodes[index].maxy[k]  = b.max.y;
+    ctx->nodes[index].maxz[k]  = b.max.z;
+    ctx->nodes[index].child[k] = child;
+    ctx->nodes[index].count[k] = leaf;
+  }
+
+  return index;
+}
+
+int bvhBuild(bvh *b, const aabb *boxes, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  context ctx;
+  size_t  i;
+
+  /* every inner node but the root has at least two children, so there are
+   * never more nodes than primitives
+   */
+  ctx.boxes     = boxes;
+  ctx.centroids = malloc((count ? count : 1) * sizeof(vec3f));
+  ctx.prims     = malloc((count ? count : 1) * sizeof(s32));
+  ctx.nodes     = malloc((count ? count : 1) * sizeof(bvhNode));
+  ctx.nodeCount = 0;
+
+  if(!ctx.centroids || !ctx.prims || !ctx.nodes)
+  {
+    free(ctx.centroids);
+    free(ctx.prims);
+    free(ctx.nodes);
+    return 0;
+  }
+
+  for(i = 0; i < count; ++i)
+  {
+    ctx.centroids[i] = vec3fScale(vec3fAdd(boxes[i].min, boxes[i].max), 0.5f);
+    ctx.prims[i]     = (s32)i;
+  }
+
+  build(&ctx, 0, count, 0);
+
+  free(ctx.centroids);
+
+  b->nodes     = ctx.nodes;
+  b->nodeCount = ctx.nodeCount;
+  b->prims     = ctx.prims;
+  b->primCount = count;
+
+  return 1;
+}
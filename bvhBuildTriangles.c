@@ -0,0 +1,24 @@
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int bvhBuildTriangles(bvh *b, const vec3f *vertices, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  aabb   *boxes = malloc((count ? count : 1) * sizeof(aabb));
+  size_t i;
+  int    rc;
+
+  if(!boxes)
+    return 0;
+
+  for(i = 0; i < count; ++i)
+    aabbFromPoints(&boxes[i], &vertices[i*3], 3);
+
+  rc = bvhBuild(b, boxes, count);
+
+  free(boxes);
+
+  return rc;
+}
@@ -0,0 +1,116 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#define STACK_SIZE 256
+
+int bvhClosestHit(const bvh *b, const ray *r, const vec3f *vertices, float *t, s32 *prim)
+{
+  PROFILE_FUNCTION();
+
+  s32   stack[STACK_SIZE];
+  float stackNear[STACK_SIZE];
+  int   sp = 0;
+  float best = *t;
+  s32   bestPrim = -1;
+  vec3f o   = r->origin;
+  vec3f inv = { 1.0f / r->direction.x, 1.0f / r->direction.y, 1.0f / r->direction.z };
+
+  if(b->nodeCount == 0)
+    return 0;
+
+  stack[sp]     = 0;
+  stackNear[sp] = 0.0f;
+  ++sp;
+
+  while(sp > 0)
+  {
+    const bvhNode *node;
+    float         near[4];
+    int           order[4], n = 0;
+    int           k, m;
+
+    --sp;
+    if(stackNear[sp] >= best)
+      continue;
+
+    node = &b->nodes[stack[sp]];
+
+    /* slab test all four children */
+    for(k = 0; k < 4; ++k)
+    {
+      float x1 = (node->minx[k] - o.x) * inv.x, x2 = (node->maxx[k] - o.x) * inv.x;
+      float y1 = (node->miny[k] - o.y) * inv.y, y2 = (node->maxy[k] - o.y) * inv.y;
+      float z1 = (node->minz[k] - o.z) * inv.z, z2 = (node->maxz[k] - o.z) * inv.z;
+
+      float nx = x1 < x2 ? x1 : x2, fx = x1 < x2 ? x2 : x1;
+      float ny = y1 < y2 ? y1 : y2, fy = y1 < y2 ? y2 : y1;
+      float nz = z1 < z2 ? z1 : z2, fz = z1 < z2 ? z2 : z1;
+
+      float tn = nx > 0.0f ? nx : 0.0f;
+      float tf = fx;
+
+      tn = ny > tn ? ny : tn;
+      tn = nz > tn ? nz : tn;
+      tf = fy < tf ? fy : tf;
+      tf = fz < tf ? fz : tf;
+
+      near[k] = (tn <= tf && tn < best) ? tn : INFINITY;
+    }
+
+    /* sort the hit children front to back */
+    for(k = 0; k < 4; ++k)
+    {
+      if(node->child[k] < 0 || isinf(near[k]))
+        continue;
+
+      for(m = n++; m > 0 && near[order[m-1]] > near[k]; --m)
+        order[m] = order[m-1];
+      order[m] = k;
+    }
+
+    /* test leaves immediately */
+    for(m = 0; m < n; ++m)
+    {
+      s32 j;
+
+      k = order[m];
+      if(node->count[k] == 0 || near[k] >= best)
+        continue;
+
+      for(j = node->child[k]; j < node->child[k] + node->count[k]; ++j)
+      {
+        s32   p = b->prims[j];
+        float ht;
+
+        if(rayTriangle(r, vertices[p*3+0], vertices[p*3+1], vertices[p*3+2], &ht, NULL, NULL)
+        && ht < best)
+        {
+          best     = ht;
+          bestPrim = p;
+        }
+      }
+    }
+
+    /* push inner nodes back to front */
+    for(m = n; m-- > 0; )
+    {
+      k = order[m];
+      if(node->count[k] != 0 || near[k] >= best)
+        continue;
+
+      stack[sp]     = node->child[k];
+      stackNear[sp] = near[k];
+      ++sp;
+    }
+  }
+
+  if(bestPrim < 0)
+    return 0;
+
+  *t = best;
+  if(prim)
+    *prim = bestPrim;
+
+  return 1;
+}
@@ -0,0 +1,16 @@
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void bvhFree(bvh *b)
+{
+  PROFILE_FUNCTION();
+
+  free(b->nodes);
+  free(b->prims);
+
+  b->nodes     = NULL;
+  b->nodeCount = 0;
+  b->prims     = NULL;
+  b->primCount = 0;
+}
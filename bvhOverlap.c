@@ -0,0 +1,62 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#define STACK_SIZE 256
+
+size_t bvhOverlap(const bvh *b, const aabb *boxes, const aabb *box, s32 *prims, size_t max)
+{
+  PROFILE_FUNCTION();
+
+  s32    stack[STACK_SIZE];
+  int    sp = 0;
+  size_t found = 0;
+
+  if(b->nodeCount == 0)
+    return 0;
+
+  stack[sp++] = 0;
+
+  while(sp > 0)
+  {
+    const bvhNode *node = &b->nodes[stack[--sp]];
+    int           hit[4];
+    int           k;
+
+    for(k = 0; k < 4; ++k)
+    {
+      hit[k] = (node->minx[k] <= box->max.x) & (node->maxx[k] >= box->min.x)
+             & (node->miny[k] <= box->max.y) & (node->maxy[k] >= box->min.y)
+             & (node->minz[k] <= box->max.z) & (node->maxz[k] >= box->min.z);
+    }
+
+    for(k = 0; k < 4; ++k)
+    {
+      s32 j;
+
+      if(node->child[k] < 0 || !hit[k])
+        continue;
+
+      if(node->count[k] == 0)
+      {
+        stack[sp++] = node->child[k];
+        continue;
+      }
+
+      for(j = node->child[k]; j < node->child[k] + node->count[k]; ++j)
+      {
+        const aabb *p = boxes ? &boxes[b->prims[j]] : NULL;
+
+        if(p && !(p->min.x <= box->max.x && p->max.x >= box->min.x
+               && p->min.y <= box->max.y && p->max.y >= box->min.y
+               && p->min.z <= box->max.z && p->max.z >= box->min.z))
+          continue;
+
+        if(found < max)
+          prims[found] = b->prims[j];
+        ++found;
+      }
+    }
+  }
+
+  return found;
+}
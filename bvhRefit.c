@@ -0,0 +1,66 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void bvhRefit(bvh *b, const aabb *boxes)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+  s32    j;
+  int    k, c;
+
+  /* children always come after their parent, so walk backwards */
+  for(i = b->nodeCount; i-- > 0; )
+  {
+    bvhNode *node = &b->nodes[i];
+
+    for(k = 0; k < 4; ++k)
+    {
+      aabb box = { {  INFINITY,  INFINITY,  INFINITY },
+                   { -INFINITY, -INFINITY, -INFINITY } };
+
+      if(node->child[k] < 0)
+        continue;
+
+      if(node->count[k] > 0)
+      {
+        for(j = node->child[k]; j < node->child[k] + node->count[k]; ++j)
+        {
+          const aabb *p = &boxes[b->prims[j]];
+
+          box.min.x = p->min.x < box.min.x ? p->min.x : box.min.x;
+          box.min.y = p->min.y < box.min.y ? p->min.y : box.min.y;
+          box.min.z = p->min.z < box.min.z ? p->min.z : box.min.z;
+          box.max.x = p->max.x > box.max.x ? p->max.x : box.max.x;
+          box.max.y = p->max.y > box.max.y ? p->max.y : box.max.y;
+          box.max.z = p->max.z > box.max.z ? p->max.z : box.max.z;
+        }
+      }
+      else
+      {
+        const bvhNode *n = &b->nodes[node->child[k]];
+
+        for(c = 0; c < 4; ++c)
+        {
+          if(n->child[c] < 0)
+            continue;
+
+          box.min.x = n->minx[c] < box.min.x ? n->minx[c] : box.min.x;
+          box.min.y = n->miny[c] < box.min.y ? n->miny[c] : box.min.y;
+          box.min.z = n->minz[c] < box.min.z ? n->minz[c] : box.min.z;
+          box.max.x = n->maxx[c] > box.max.x ? n->maxx[c] : box.max.x;
+          box.max.y = n->maxy[c] > box.max.y ? n->maxy[c] : box.max.y;
+          box.max.z = n->maxz[c] > box.max.z ? n->maxz[c] : box.max.z;
+        }
+      }
+
+      node->minx[k] = box.min.x;
+      node->miny[k] = box.min.y;
+      node->minz[k] = box.min.z;
+      node->maxx[k] = box.max.x;
+      node->maxy[k] = box.max.y;
+      node->maxz[k] = box.max.z;
+    }
+  }
+}
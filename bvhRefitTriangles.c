@@ -0,0 +1,69 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void bvhRefitTriangles(bvh *b, const vec3f *vertices)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+  s32    j;
+  int    k, c;
+
+  /* children always come after their parent, so walk backwards */
+  for(i = b->nodeCount; i-- > 0; )
+  {
+    bvhNode *node = &b->nodes[i];
+
+    for(k = 0; k < 4; ++k)
+    {
+      aabb box = { {  INFINITY,  INFINITY,  INFINITY },
+                   { -INFINITY, -INFINITY, -INFINITY } };
+
+      if(node->child[k] < 0)
+        continue;
+
+      if(node->count[k] > 0)
+      {
+        for(j = node->child[k]; j < node->child[k] + node->count[k]; ++j)
+        {
+          const vec3f *p = &vertices[b->prims[j]*3];
+
+          for(c = 0; c < 3; ++c)
+          {
+            box.min.x = p[c].x < box.min.x ? p[c].x : box.min.x;
+            box.min.y = p[c].y < box.min.y ? p[c].y : box.min.y;
+            box.min.z = p[c].z < box.min.z ? p[c].z : box.min.z;
+            box.max.x = p[c].x > box.max.x ? p[c].x : box.max.x;
+            box.max.y = p[c].y > box.max.y ? p[c].y : box.max.y;
+            box.max.z = p[c].z > box.max.z ? p[c].z : box.max.z;
+          }
+        }
+      }
+      else
+      {
+        const bvhNode *n = &b->nodes[node->child[k]];
+
+        for(c = 0; c < 4; ++c)
+        {
+          if(n->child[c] < 0)
+            continue;
+
+          box.min.x = n->minx[c] < box.min.x ? n->minx[c] : box.min.x;
+          box.min.y = n->miny[c] < box.min.y ? n->miny[c] : box.min.y;
+          box.min.z = n->minz[c] < box.min.z ? n->minz[c] : box.min.z;
+          box.max.x = n->maxx[c] > box.max.x ? n->maxx[c] : box.max.x;
+          box.max.y = n->maxy[c] > box.max.y ? n->maxy[c] : box.max.y;
+          box.max.z = n->maxz[c] > box.max.z ? n->maxz[c] : box.max.z;
+        }
+      }
+
+      node->minx[k] = box.min.x;
+      node->miny[k] = box.min.y;
+      node->minz[k] = box.min.z;
+      node->maxx[k] = box.max.x;
+      node->maxy[k] = box.max.y;
+      node->maxz[k] = box.max.z;
+    }
+  }
+}
@@ -0,0 +1,153 @@
+#include <assert.h>
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#define VIEW            0x01
+#define PROJECTION      0x02
+#define VIEW_PROJECTION 0x04
+#define INVERSE         0x08
+#define FRUSTUM         0x10
+
+/* everything that depends on the view or the projection */
+#define DERIVED (VIEW_PROJECTION | INVERSE | FRUSTUM)
+
+static void
+setProjection(camera *c, cameraMode mode, const float *params, int count)
+{
+  if(c->mode == mode && memcmp(c->params, params, count * sizeof(float)) == 0)
+    return;
+
+  c->mode = mode;
+  memset(c->params, 0, sizeof(c->params));
+  memcpy(c->params, params, count * sizeof(float));
+  c->dirty |= PROJECTION | DERIVED;
+}
+
+void cameraInit(camera *c)
+{
+  PROFILE_FUNCTION();
+
+  memset(c, 0, sizeof(*c));
+
+  c->target = (vec3f){ 0.0f, 0.0f, -1.0f };
+  c->up     = (vec3f){ 0.0f, 1.0f,  0.0f };
+  c->dirty  = VIEW | PROJECTION | DERIVED;
+}
+
+void cameraLookAt(camera *c, vec3f eye, vec3f target, vec3f up)
+{
+  PROFILE_FUNCTION();
+
+  if(memcmp(&c->eye, &eye, sizeof(eye)) == 0
+  && memcmp(&c->target, &target, sizeof(target)) == 0
+  && memcmp(&c->up, &up, sizeof(up)) == 0)
+    return;
+
+  c->eye    = eye;
+  c->target = target;
+  c->up     = up;
+  c->dirty |= VIEW | DERIVED;
+}
+
+void cameraPerspective(camera *c, float fovy, float aspect, float near, float far)
+{
+  PROFILE_FUNCTION();
+
+  float params[4] = { fovy, aspect, near, far };
+  setProjection(c, CAMERA_PERSPECTIVE, params, 4);
+}
+
+void cameraOrtho(camera *c, float left, float right, float bottom, float top, float near, float far)
+{
+  PROFILE_FUNCTION();
+
+  float params[6] = { left, right, bottom, top, near, far };
+  setProjection(c, CAMERA_ORTHOGRAPHIC, params, 6);
+}
+
+const mtx44* cameraView(camera *c)
+{
+  PROFILE_FUNCTION();
+
+  if(c->dirty & VIEW)
+  {
+    mtx44LookAt(&c->view, c->eye, c->target, c->up);
+    c->dirty &= ~VIEW;
+  }
+
+  return &c->view;
+}
+
+const mtx44* cameraProjection(camera *c)
+{
+  PROFILE_FUNCTION();
+
+  if(c->dirty & PROJECTION)
+  {
+    const float *p = c->params;
+
+    switch(c->mode)
+    {
+      case CAMERA_IDENTITY:
+        mtx44Identity(&c->projection);
+        break;
+
+      case CAMERA_ORTHOGRAPHIC:
+        mtx44Ortho(&c->projection, p[0], p[1], p[2], p[3], p[4], p[5]);
+        break;
+
+      default:
+        assert(!"unknown camera mode");
+        /* fall through */
+
+      case CAMERA_PERSPECTIVE:
+        mtx44Perpective(&c->projection, p[0], p[1], p[2], p[3]);
+        break;
+    }
+
+    c->dirty &= ~PROJECTION;
+  }
+
+  return &c->projection;
+}
+
+const mtx44* cameraViewProjection(camera *c)
+{
+  PROFILE_FUNCTION();
+
+  if(c->dirty & VIEW_PROJECTION)
+  {
+    mtx44Multiply(&c->viewProjection, cameraProjection(c), cameraView(c));
+    c->dirty &= ~VIEW_PROJECTION;
+  }
+
+  return &c->viewProjection;
+}
+
+const mtx44* cameraInverseViewProjection(camera *c)
+{
+  PROFILE_FUNCTION();
+
+  if(c->dirty & INVERSE)
+  {
+    if(!mtx44Inverse(&c->inverseViewProjection, cameraViewProjection(c)))
+      mtx44Identity(&c->inverseViewProjection);
+    c->dirty &= ~INVERSE;
+  }
+
+  return &c->inverseViewProjection;
+}
+
+const vec4f* cameraFrustum(camera *c)
+{
+  PROFILE_FUNCTION();
+
+  if(c->dirty & FRUSTUM)
+  {
+    mtx44FrustumPlanes(c->frustum, cameraViewProjection(c));
+    c->dirty &= ~FRUSTUM;
+  }
+
+  return c->frustum;
+}
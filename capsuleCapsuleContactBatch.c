@@ -0,0 +1,59 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+size_t capsuleCapsuleContactBatch(contactSoA out, capsuleSoA a, capsuleSoA b, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  const v4f zero = v4fSplat(0.0f), one = v4fSplat(1.0f);
+
+  size_t n, k, touching = 0;
+
+  for(n = 0; n < count; n += 4)
+  {
+    size_t lanes = count - n < 4 ? count - n : 4;
+
+    v4f3 p1 = v4f3LoadN(a.a, n, lanes), d1 = v4f3Subtract(v4f3LoadN(a.b, n, lanes), p1);
+    v4f3 p2 = v4f3LoadN(b.a, n, lanes), d2 = v4f3Subtract(v4f3LoadN(b.b, n, lanes), p2);
+    v4f3 r  = v4f3Subtract(p1, p2);
+    v4f3 normal, point;
+
+    /* closest points of the two axes (Ericson, Real-Time Collision
+     * Detection 5.1.9), with selects in place of its branches; a zero-length
+     * segment has d = 0, which the safe divisors turn into s or t = 0
+     */
+    v4f aa    = v4f3Dot(d1, d1);
+    v4f ee    = v4f3Dot(d2, d2);
+    v4f bb    = v4f3Dot(d1, d2);
+    v4f c     = v4f3Dot(d1, r);
+    v4f f     = v4f3Dot(d2, r);
+    v4f denom = aa*ee - bb*bb;
+    v4f as    = v4fSelect(aa > zero, aa, one);
+    v4f es    = v4fSelect(ee > zero, ee, one);
+    v4i skew  = denom > zero;
+    v4f s, t, depth;
+
+    /* parallel axes: start from the point of axis a closest to b's start */
+    s = v4fSelect(skew, (bb*f - c*ee) / v4fSelect(skew, denom, one), -c / as);
+    s = v4fClamp(s, zero, one);
+    t = (bb*s + f) / es;
+
+    s = v4fSelect(t < zero, v4fClamp(-c / as, zero, one),
+        v4fSelect(t > one,  v4fClamp((bb - c) / as, zero, one), s));
+    t = v4fClamp(t, zero, one);
+
+    depth = v4fSphereContact(&normal, &point,
+                             v4f3Add(p1, v4f3Scale(d1, s)), v4fLoadN(a.radius + n, lanes),
+                             v4f3Add(p2, v4f3Scale(d2, t)), v4fLoadN(b.radius + n, lanes));
+
+    v4f3StoreN(out.normal, n, normal, lanes);
+    v4f3StoreN(out.point, n, point, lanes);
+    v4fStoreN(out.depth + n, depth, lanes);
+
+    for(k = 0; k < lanes; ++k)
+      touching += depth[k] >= 0.0f;
+  }
+
+  return touching;
+}
@@ -0,0 +1,24 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void cubicEvaluateBatch(vec3f *out, const cubic *c, const float *t, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  /* hoist the coefficients so the loop is a pure Horner sweep over t */
+  v4f3   a = v4f3Splat(c->a);
+  v4f3   b = v4f3Splat(c->b);
+  v4f3   e = v4f3Splat(c->c);
+  v4f3   d = v4f3Splat(c->d);
+  size_t n, k;
+
+  for(n = 0; n < count; n += 4)
+  {
+    size_t lanes = count - n < 4 ? count - n : 4;
+    v4f3   p     = v4f3Cubic(a, b, e, d, v4fLoadN(t + n, lanes));
+
+    for(k = 0; k < lanes; ++k)
+      out[n + k] = v4f3Extract(p, (int)k);
+  }
+}
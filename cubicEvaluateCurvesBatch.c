@@ -0,0 +1,32 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void cubicEvaluateCurvesBatch(vec3f *out, const cubic *curves, const float *t, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n, k;
+
+  /* four curves per iteration; a partial tail repeats the first curve */
+  for(n = 0; n < count; n += 4)
+  {
+    size_t lanes = count - n < 4 ? count - n : 4;
+    v4f3   a, b, c, d, p;
+
+    for(k = 0; k < 4; ++k)
+    {
+      const cubic *curve = &curves[n + (k < lanes ? k : 0)];
+
+      v4f3Insert(&a, (int)k, curve->a);
+      v4f3Insert(&b, (int)k, curve->b);
+      v4f3Insert(&c, (int)k, curve->c);
+      v4f3Insert(&d, (int)k, curve->d);
+    }
+
+    p = v4f3Cubic(a, b, c, d, v4fLoadN(t + n, lanes));
+
+    for(k = 0; k < lanes; ++k)
+      out[n + k] = v4f3Extract(p, (int)k);
+  }
+}
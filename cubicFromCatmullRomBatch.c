@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void cubicFromCatmullRomBatch(cubic *out, const vec3f *points, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+
+  for(n = 0; n + 3 < count; ++n)
+    out[n] = cubicFromCatmullRom(points[n], points[n+1], points[n+2], points[n+3]);
+}
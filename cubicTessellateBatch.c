@@ -0,0 +1,56 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void cubicTessellateBatch(vec3f *out, const cubic *curves, size_t count, size_t steps)
+{
+  PROFILE_FUNCTION();
+
+  float  h  = 1.0f / steps, h2 = h*h, h3 = h2*h;
+  v4f    vh = v4fSplat(h), vh2 = v4fSplat(h2), vh3 = v4fSplat(h3);
+  size_t n, i, k;
+
+  /* forward-difference four curves at once, one per lane, with the same
+   * arithmetic as cubicForwardInit/cubicForwardStep
+   */
+  for(n = 0; n < count; n += 4)
+  {
+    size_t lanes = count - n < 4 ? count - n : 4;
+    vec3f  *dst  = out + n*(steps + 1);
+    v4f3   a, b, c, d, p, d1, d2, d3;
+
+    for(k = 0; k < 4; ++k)
+    {
+      const cubic *curve = &curves[n + (k < lanes ? k : 0)];
+
+      v4f3Insert(&a, (int)k, curve->a);
+      v4f3Insert(&b, (int)k, curve->b);
+      v4f3Insert(&c, (int)k, curve->c);
+      v4f3Insert(&d, (int)k, curve->d);
+    }
+
+    p  = d;
+    d1 = v4f3Add(v4f3Add(v4f3Scale(a, vh3), v4f3Scale(b, vh2)), v4f3Scale(c, vh));
+    d2 = v4f3Add(v4f3Scale(v4f3Scale(a, v4fSplat(6.0f)), vh3),
+                 v4f3Scale(v4f3Scale(b, v4fSplat(2.0f)), vh2));
+    d3 = v4f3Scale(a, v4fSplat(6.0f*h3));
+
+    for(k = 0; k < lanes; ++k)
+      dst[k*(steps + 1)] = v4f3Extract(p, (int)k);
+
+    for(i = 1; i < steps; ++i)
+    {
+      p  = v4f3Add(p,  d1);
+      d1 = v4f3Add(d1, d2);
+      d2 = v4f3Add(d2, d3);
+
+      for(k = 0; k < lanes; ++k)
+        dst[k*(steps + 1) + i] = v4f3Extract(p, (int)k);
+    }
+
+    /* t = 1 directly, so the stepping error does not reach the end point */
+    p = v4f3Add(v4f3Add(v4f3Add(a, b), c), d);
+    for(k = 0; k < lanes; ++k)
+      dst[k*(steps + 1) + steps] = v4f3Extract(p, (int)k);
+  }
+}
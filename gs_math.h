@@ -4,10 +4,21 @@
 #include <3ds.h>
 #else
 #include <stdint.h>
-typedef int32_t s32;
+typedef uint8_t  u8;
+typedef int8_t   s8;
+typedef int16_t  s16;
+typedef uint16_t u16;
+typedef int32_t  s32;
+typedef uint32_t u32;
+typedef uint64_t u64;
 #endif
 
 #include <math.h>
+#include <stddef.h>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
 
 /*! 3D int vector */
 typedef struct
@@ -40,6 +51,383 @@ typedef struct
   float k; /*!< k-component */
 } quat;
 
+/*! vec3f array in SoA layout */
+typedef struct
+{
+  float *x; /*!< x-components */
+  float *y; /*!< y-components */
+  float *z; /*!< z-components */
+} vec3fSoA;
+
+/*! Quaternion array in SoA layout */
+typedef struct
+{
+  float *r; /*!< real components */
+  float *i; /*!< i-components */
+  float *j; /*!< j-components */
+  float *k; /*!< k-components */
+} quatSoA;
+
+/*! Spheres in SoA layout */
+typedef struct
+{
+  vec3fSoA center; /*!< centers */
+  float   *radius; /*!< radii */
+} sphereSoA;
+
+/*! Capsules (swept spheres) in SoA layout */
+typedef struct
+{
+  vec3fSoA a;      /*!< axis start points */
+  vec3fSoA b;      /*!< axis end points */
+  float   *radius; /*!< radii */
+} capsuleSoA;
+
+/*! Axis-aligned bounding boxes in SoA layout */
+typedef struct
+{
+  vec3fSoA min; /*!< minimum corners */
+  vec3fSoA max; /*!< maximum corners */
+} aabbSoA;
+
+/*! Contacts in SoA layout, one per tested pair */
+typedef struct
+{
+  vec3fSoA normal; /*!< unit normal from the first shape towards the second */
+  vec3fSoA point;  /*!< point midway between the two surfaces */
+  float   *depth;  /*!< penetration depth (negative when apart) */
+} contactSoA;
+
+/*! 4D float vector; also the padded, 16-byte aligned storage form of vec3f */
+typedef struct
+{
+  float x; /*!< x-component */
+  float y; /*!< y-component */
+  float z; /*!< z-component */
+  float w; /*!< w-component */
+} __attribute__((aligned(16))) vec4f;
+
+/*! mtx44 aligned to a 64-byte cache line */
+typedef mtx44 mtx44a __attribute__((aligned(64)));
+
+/*! quat aligned to 16 bytes */
+typedef quat quata __attribute__((aligned(16)));
+
+/*! Linear arena allocator
+ *
+ *  Allocations are carved sequentially out of one block and released all at
+ *  once by arenaReset.
+ */
+typedef struct
+{
+  unsigned char *base; /*!< storage (64-byte aligned) */
+  size_t         size; /*!< capacity in bytes */
+  size_t         used; /*!< bytes handed out */
+} arena;
+
+/*! Lock-free triple buffer for handing frames from one writer thread to one
+ *  reader thread
+ *
+ *  The writer fills its buffer and publishes it with one atomic exchange;
+ *  the reader picks up the latest published buffer with another. Neither
+ *  side blocks or copies.
+ */
+typedef struct
+{
+  void  *buffer[3]; /*!< storage (64-byte aligned) */
+  u64    frame[3];  /*!< frame number held by each buffer */
+  size_t size;      /*!< bytes per buffer */
+
+  u32 state __attribute__((aligned(64))); /*!< shared buffer index | fresh flag */
+  u32 write __attribute__((aligned(64))); /*!< writer's buffer index */
+  u64 published;                          /*!< frames published */
+  u32 read  __attribute__((aligned(64))); /*!< reader's buffer index */
+} tripleBuffer;
+
+/*! Camera projection modes */
+typedef enum
+{
+  CAMERA_IDENTITY     = 0, /*!< no projection */
+  CAMERA_PERSPECTIVE  = 1, /*!< perspective (mtx44Perpective) */
+  CAMERA_ORTHOGRAPHIC = 2, /*!< orthographic (mtx44Ortho) */
+} cameraMode;
+
+/*! Camera with lazily computed matrices
+ *
+ *  The setters only invalidate what their inputs affect, and only if the
+ *  inputs actually changed; the getters recompute whatever is stale.
+ */
+typedef struct
+{
+  vec3f      eye;                   /*!< eye position */
+  vec3f      target;                /*!< point looked at */
+  vec3f      up;                    /*!< up direction */
+  cameraMode mode;                  /*!< projection mode */
+  float      params[6];             /*!< projection parameters */
+  u32        dirty;                 /*!< stale matrices */
+  mtx44      view;                  /*!< view matrix */
+  mtx44      projection;            /*!< projection matrix */
+  mtx44      viewProjection;        /*!< projection * view */
+  mtx44      inverseViewProjection; /*!< inverse of viewProjection */
+  vec4f      frustum[6];            /*!< frustum planes */
+} camera;
+
+/*! Axis-aligned bounding box */
+typedef struct
+{
+  vec3f min; /*!< minimum corner */
+  vec3f max; /*!< maximum corner */
+} aabb;
+
+/*! Bounding sphere */
+typedef struct
+{
+  vec3f center; /*!< center */
+  float radius; /*!< radius */
+} sphere;
+
+/*! Oriented bounding box */
+typedef struct
+{
+  vec3f center;  /*!< center */
+  vec3f axis[3]; /*!< orthonormal axes (right-handed) */
+  vec3f extent;  /*!< half-extents along each axis */
+} obb;
+
+/*! Ray */
+typedef struct
+{
+  vec3f origin;    /*!< origin */
+  vec3f direction; /*!< direction (need not be normalized) */
+} ray;
+
+/*! Packet of 4 rays (SoA) */
+typedef struct
+{
+  float ox[4]; /*!< origin x-components */
+  float oy[4]; /*!< origin y-components */
+  float oz[4]; /*!< origin z-components */
+  float dx[4]; /*!< direction x-components */
+  float dy[4]; /*!< direction y-components */
+  float dz[4]; /*!< direction z-components */
+} ray4;
+
+/*! Packet of 8 rays (SoA) */
+typedef struct
+{
+  float ox[8]; /*!< origin x-components */
+  float oy[8]; /*!< origin y-components */
+  float oz[8]; /*!< origin z-components */
+  float dx[8]; /*!< direction x-components */
+  float dy[8]; /*!< direction y-components */
+  float dz[8]; /*!< direction z-components */
+} ray8;
+
+/*! 4-wide BVH node
+ *
+ *  Child bounds are stored SoA so that all four can be tested at once. A
+ *  child with count > 0 is a leaf referencing bvh::prims[child] through
+ *  bvh::prims[child+count-1]; a child with count == 0 is the inner node
+ *  bvh::nodes[child], or an unused slot if child < 0.
+ */
+typedef struct
+{
+  float minx[4];  /*!< child minimum x */
+  float miny[4];  /*!< child minimum y */
+  float minz[4];  /*!< child minimum z */
+  float maxx[4];  /*!< child maximum x */
+  float maxy[4];  /*!< child maximum y */
+  float maxz[4];  /*!< child maximum z */
+  s32   child[4]; /*!< child node or first primitive */
+  s32   count[4]; /*!< leaf primitive count */
+} bvhNode;
+
+/*! Bounding volume hierarchy
+ *
+ *  Nodes are stored depth-first; bvh::nodes[0] is the root and every child
+ *  node comes after its parent.
+ */
+typedef struct
+{
+  bvhNode *nodes;     /*!< nodes */
+  size_t   nodeCount; /*!< number of nodes */
+  s32     *prims;     /*!< primitive indices referenced by leaves */
+  size_t   primCount; /*!< number of primitives */
+} bvh;
+
+/*! Spatial hash grid slot */
+typedef struct
+{
+  vec3i cell;  /*!< cell coordinates */
+  u32   first; /*!< first entry in hashGrid::entries */
+  u32   count; /*!< number of entries (0 for an unused slot) */
+} hashGridSlot;
+
+/*! Uniform spatial hash grid
+ *
+ *  Objects are bucketed by the cell containing their position. The slot
+ *  table is open-addressed with linear probing and at most half full.
+ */
+typedef struct
+{
+  float         cellSize;    /*!< cell edge length */
+  float         invCellSize; /*!< 1/cellSize */
+  hashGridSlot *slots;       /*!< slot table */
+  size_t        slotCount;   /*!< number of slots (power of two) */
+  s32          *entries;     /*!< object indices grouped by cell */
+  vec3i        *cells;       /*!< cell of each object */
+  u32          *hashes;      /*!< cell hash of each object */
+  size_t        objectCount; /*!< number of objects */
+  size_t        capacity;    /*!< number of objects storage is sized for */
+} hashGrid;
+
+/*! Cubic curve segment in power basis: a*t^3 + b*t^2 + c*t + d, t in [0,1] */
+typedef struct
+{
+  vec3f a; /*!< cubic coefficient */
+  vec3f b; /*!< quadratic coefficient */
+  vec3f c; /*!< linear coefficient */
+  vec3f d; /*!< constant coefficient (the point at t = 0) */
+} cubic;
+
+/*! Forward-differencing state for stepping a cubic by a fixed increment */
+typedef struct
+{
+  vec3f p;  /*!< current point */
+  vec3f d1; /*!< first difference */
+  vec3f d2; /*!< second difference */
+  vec3f d3; /*!< third difference (constant) */
+} cubicForward;
+
+/*! Number of arbitrary-axis rotations kept by a rotationCache */
+#define ROTATION_CACHE_AXES 16
+
+/*! Arbitrary-axis rotation kept by a rotationCache */
+typedef struct
+{
+  vec3f axis;    /*!< axis as passed in */
+  u32   step;    /*!< quantized angle */
+  u32   used;    /*!< last use (0 for an unused slot) */
+  float m[3][3]; /*!< rotation block, laid out like mtx44 columns */
+} rotationCacheAxis;
+
+/*! Rotation cache for angles quantized to a fixed number of steps per turn
+ *
+ *  Rotations about X, Y and Z only need the step's sine and cosine, which
+ *  come from a table. Rotations about other axes keep their 3x3 block in a
+ *  small least-recently-used set.
+ */
+typedef struct
+{
+  float            *table; /*!< sin/cos pairs at every half step */
+  u32               steps; /*!< steps per turn */
+  u32               clock; /*!< use counter for the LRU set */
+  rotationCacheAxis axes[ROTATION_CACHE_AXES]; /*!< LRU set */
+} rotationCache;
+
+/*! Bone transform relative to its parent: scale, then rotate, then translate */
+typedef struct
+{
+  quat  rotation;    /*!< rotation (unit quaternion) */
+  vec3f translation; /*!< translation */
+  vec3f scale;       /*!< scale */
+} boneTransform;
+
+/*! Skeleton
+ *
+ *  Bones are stored in topological order: every bone's parent comes before
+ *  it, so world matrices can be built in one forward pass.
+ */
+typedef struct
+{
+  s32   *parents;     /*!< parent of each bone (-1 for a root) */
+  mtx44 *inverseBind; /*!< inverse bind matrix of each bone */
+  size_t count;       /*!< number of bones */
+} skeleton;
+
+/*! Capacity of the instrumentation function table */
+#define PROFILE_MAX_FUNCTIONS 256
+
+/*! Instrumentation counters for one function */
+typedef struct
+{
+  const char *name;  /*!< function name */
+  u64         calls; /*!< calls since the last profileReset */
+  u64         ticks; /*!< inclusive time since the last profileReset */
+} profileEntry;
+
+/*! Work-stealing thread pool (opaque) */
+typedef struct threadPool threadPool;
+
+/*! Range callback for threadPoolFor
+ *
+ *  @param[in] arg   User argument
+ *  @param[in] first First index
+ *  @param[in] count Number of indices
+ */
+typedef void (*threadPoolFunc)(void *arg, size_t first, size_t count);
+
+/*! mathFile magic ("GSMF" read as a little-endian u32) */
+#define MATH_FILE_MAGIC   0x464D5347u
+/*! mathFile format version written by mathFileWrite */
+#define MATH_FILE_VERSION 1u
+/*! mathFile section data alignment */
+#define MATH_FILE_ALIGN   64u
+
+/*! mathFile section element types */
+enum
+{
+  MATH_FILE_BYTES = 0, /*!< raw bytes */
+  MATH_FILE_FLOAT = 1, /*!< float */
+  MATH_FILE_VEC3F = 2, /*!< vec3f */
+  MATH_FILE_VEC4F = 3, /*!< vec4f */
+  MATH_FILE_QUAT  = 4, /*!< quat */
+  MATH_FILE_MTX44 = 5, /*!< mtx44 */
+  MATH_FILE_S32   = 6, /*!< s32 */
+};
+
+/*! mathFile header, at offset 0 (all fields little-endian) */
+typedef struct
+{
+  u32 magic;        /*!< MATH_FILE_MAGIC */
+  u32 version;      /*!< format version */
+  u32 endian;       /*!< 0x01020304 */
+  u32 sectionCount; /*!< number of section entries */
+  u64 fileSize;     /*!< total size in bytes */
+  u64 tableOffset;  /*!< offset of the section table */
+} mathFileHeader;
+
+/*! mathFile section table entry */
+typedef struct
+{
+  u32 type;     /*!< element type */
+  u32 id;       /*!< user identifier */
+  u64 offset;   /*!< data offset, a multiple of MATH_FILE_ALIGN */
+  u64 count;    /*!< number of elements */
+  u32 checksum; /*!< FNV-1a of the data */
+  u32 reserved; /*!< zero */
+} mathFileSection;
+
+/*! Section to be written by mathFileWrite */
+typedef struct
+{
+  u32         type;  /*!< element type */
+  u32         id;    /*!< user identifier */
+  const void *data;  /*!< elements */
+  size_t      count; /*!< number of elements */
+} mathFileSource;
+
+/*! Opened, validated mathFile */
+typedef struct
+{
+  const void            *base;     /*!< file contents */
+  size_t                 size;     /*!< file size in bytes */
+  const mathFileHeader  *header;   /*!< header */
+  const mathFileSection *sections; /*!< section table */
+  int                    mapped;   /*!< whether base is a mapping we own */
+  void                  *storage;  /*!< heap copy we own, if not mapped */
+} mathFile;
+
 /*! Add two vec3i's component-wise
  *
  *  @param[in] lhs Left side
@@ -98,6 +486,97 @@ vec3iCross(vec3i lhs, vec3i rhs)
                   lhs.x*rhs.y - lhs.y*rhs.x };
 }
 
+/*! Spread the low 21 bits of a value to every third bit
+ *
+ *  @param[in] x Value
+ *
+ *  @returns spread bits
+ */
+static inline u64
+mortonSpread(u64 x)
+{
+#ifdef __BMI2__
+  return _pdep_u64(x, 0x1249249249249249ULL);
+#else
+  x &= 0x1FFFFFULL;
+  x = (x | x << 32) & 0x001F00000000FFFFULL;
+  x = (x | x << 16) & 0x001F0000FF0000FFULL;
+  x = (x | x <<  8) & 0x100F00F00F00F00FULL;
+  x = (x | x <<  4) & 0x10C30C30C30C30C3ULL;
+  x = (x | x <<  2) & 0x1249249249249249ULL;
+  return x;
+#endif
+}
+
+/*! Gather every third bit of a value into the low 21 bits
+ *
+ *  @param[in] x Value
+ *
+ *  @returns compacted bits
+ */
+static inline u64
+mortonCompact(u64 x)
+{
+#ifdef __BMI2__
+  return _pext_u64(x, 0x1249249249249249ULL);
+#else
+  x &= 0x1249249249249249ULL;
+  x = (x ^ (x >>  2)) & 0x10C30C30C30C30C3ULL;
+  x = (x ^ (x >>  4)) & 0x100F00F00F00F00FULL;
+  x = (x ^ (x >>  8)) & 0x001F0000FF0000FFULL;
+  x = (x ^ (x >> 16)) & 0x001F00000000FFFFULL;
+  x = (x ^ (x >> 32)) & 0x1FFFFFULL;
+  return x;
+#endif
+}
+
+/*! Encode a vec3i as a Morton (Z-order) code
+ *
+ *  Components must be in [-2^20, 2^20); they are biased so that codes sort
+ *  in the same order as the components.
+ *
+ *  @param[in] v Vector
+ *
+ *  @returns Morton code (x in bit 0)
+ */
+static inline u64
+vec3iToMorton(vec3i v)
+{
+  return mortonSpread((u64)(v.x + 0x100000))
+       | mortonSpread((u64)(v.y + 0x100000)) << 1
+       | mortonSpread((u64)(v.z + 0x100000)) << 2;
+}
+
+/*! Decode a Morton (Z-order) code to a vec3i
+ *
+ *  @param[in] code Morton code
+ *
+ *  @returns vector
+ */
+static inline vec3i
+mortonToVec3i(u64 code)
+{
+  return (vec3i){ (s32)mortonCompact(code)      - 0x100000,
+                  (s32)mortonCompact(code >> 1) - 0x100000,
+                  (s32)mortonCompact(code >> 2) - 0x100000 };
+}
+
+/*! Hash a grid cell
+ *
+ *  @param[in] cell Cell
+ *
+ *  @returns hash
+ */
+static inline u32
+hashGridHash(vec3i cell)
+{
+  u32 h = (u32)cell.x*73856093u ^ (u32)cell.y*19349663u ^ (u32)cell.z*83492791u;
+  h ^= h >> 16;
+  h *= 0x7FEB352Du;
+  h ^= h >> 15;
+  return h;
+}
+
 /*! Add two vec3f's component-wise
  *
  *  @param[in] lhs Left side
@@ -156,6 +635,19 @@ vec3fCross(vec3f lhs, vec3f rhs)
                   lhs.x*rhs.y - lhs.y*rhs.x };
 }
 
+/*! vec3f dot-product
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs . rhs
+ */
+static inline float
+vec3fDot(vec3f lhs, vec3f rhs)
+{
+  return lhs.x*rhs.x + lhs.y*rhs.y + lhs.z*rhs.z;
+}
+
 /*! Normaliaze a vec3f
  *
  *  @param[in] v Vector
@@ -181,119 +673,320 @@ vec3iToVec3f(vec3i v)
   return (vec3f){ (float)v.x, (float)v.y, (float)v.z };
 }
 
-/*! Initialize a quaternion
+/*! Convert vec3f to its padded vec4f form
  *
- *  @param[out] q Quaternion
+ *  @param[in] v Vector
+ *  @param[in] w w-component
+ *
+ *  @returns padded vector
  */
-static inline void
-quatIdentity(quat *q)
+static inline vec4f
+vec3fToVec4f(vec3f v, float w)
 {
-  q->r = 1.0f;
-  q->i = q->j = q->k = 0.0f;
+  return (vec4f){ v.x, v.y, v.z, w };
 }
 
-/*! Negate a quaternion component-wise
+/*! Convert vec4f to vec3f, dropping w
  *
- *  @param[in] q Quaternion
+ *  @param[in] v Vector
  *
- *  @returns negated q
+ *  @returns vec3f
  */
-static inline quat
-quatNegate(quat q)
+static inline vec3f
+vec4fToVec3f(vec4f v)
 {
-  return (quat){ -q.r, -q.i, -q.j, -q.k };
+  return (vec3f){ v.x, v.y, v.z };
 }
 
-/*! Add two quaternions component-wise
+/*! Fold a unit vector onto the octahedral square
  *
- *  @param[in] lhs Left side
- *  @param[in] rhs Right side
+ *  The vector is projected onto the octahedron |x|+|y|+|z| = 1, and the
+ *  lower half (z < 0) is folded over the diagonals into the corners.
  *
- *  @returns lhs+rhs
+ *  @param[in]  n Unit vector
+ *  @param[out] x Square x-coordinate in [-1,1]
+ *  @param[out] y Square y-coordinate in [-1,1]
  */
-static inline quat
-quatAdd(quat lhs, quat rhs)
+static inline void
+octEncode(vec3f n, float *x, float *y)
 {
-  return (quat){ lhs.r + rhs.r,
-                 lhs.i + rhs.i,
-                 lhs.j + rhs.j,
-                 lhs.k + rhs.k };
+  float l = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+  float u = n.x / l;
+  float v = n.y / l;
+
+  float fu = copysignf(1.0f - fabsf(v), u);
+  float fv = copysignf(1.0f - fabsf(u), v);
+
+  /* selects rather than a branch so batch loops can vectorize */
+  *x = n.z < 0.0f ? fu : u;
+  *y = n.z < 0.0f ? fv : v;
 }
 
-/*! Subtract two quaternions component-wise
+/*! Unfold a point on the octahedral square to a unit vector
  *
- *  @param[in] lhs Left side
- *  @param[in] rhs Right side
+ *  @param[in] x Square x-coordinate in [-1,1]
+ *  @param[in] y Square y-coordinate in [-1,1]
  *
- *  @returns lhs-rhs
+ *  @returns unit vector
  */
-static inline quat
-quatSubtract(quat lhs, quat rhs)
+static inline vec3f
+octDecode(float x, float y)
 {
-  return (quat){ lhs.r - rhs.r,
-                 lhs.i - rhs.i,
-                 lhs.j - rhs.j,
-                 lhs.k - rhs.k };
+  float z = 1.0f - fabsf(x) - fabsf(y);
+  float t = z < 0.0f ? -z : 0.0f;
+
+  x -= copysignf(t, x);
+  y -= copysignf(t, y);
+
+  return vec3fNormalize((vec3f){ x, y, z });
 }
 
-/*! Scale a quaternion component-wise
+/*! Quantize an octahedral coordinate to a signed normalized integer
  *
- *  @param[in] lhs Left side
- *  @param[in] rhs Right side
+ *  @param[in] v     Coordinate in [-1,1]
+ *  @param[in] scale Largest integer value
  *
- *  @returns lhs+rhs
+ *  @returns v*scale rounded to nearest
  */
-static inline quat
-quatScale(quat q, float s)
+static inline s32
+octQuantize(float v, float scale)
 {
-  return (quat){ q.r*s, q.i*s, q.j*s, q.k*s };
+  return (s32)(v*scale + copysignf(0.5f, v));
 }
 
-/*! Normaliaze a quaternion
+/*! Encode a unit vector in 16 bits (8-bit octahedral x and y)
  *
- *  @param[in] q Quaternion
+ *  The decoded vector is within 1 degree of the original.
  *
- *  @returns normalized q
+ *  @param[in] n Unit vector
+ *
+ *  @returns x in the low byte, y in the high byte
  */
-static inline quat
-quatNormalize(quat q)
+static inline u16
+vec3fToOct16(vec3f n)
 {
-  float len = sqrtf(q.r*q.r + q.i*q.i + q.j*q.j + q.k*q.k);
+  float x, y;
 
-  return (quat){ q.r/len, q.i/len, q.j/len, q.k/len };
+  octEncode(n, &x, &y);
+
+  return (u16)((octQuantize(x, 127.0f) & 0xFF) | (octQuantize(y, 127.0f) & 0xFF) << 8);
 }
 
-/*! Quaternion dot-product
+/*! Decode a unit vector encoded by vec3fToOct16
  *
- *  @param[in] lhs Left side
- *  @param[in] rhs Right side
+ *  @param[in] o Encoded vector
  *
- *  @returns lhs . rhs
+ *  @returns unit vector
  */
-static inline float
-quatDot(quat lhs, quat rhs)
+static inline vec3f
+oct16ToVec3f(u16 o)
 {
-  return lhs.r*rhs.r
-       + lhs.i*rhs.i
-       + lhs.j*rhs.j
-       + lhs.k*rhs.k;
+  float x = (s8)(o & 0xFF) / 127.0f;
+  float y = (s8)(o >> 8)   / 127.0f;
+
+  return octDecode(x < -1.0f ? -1.0f : x, y < -1.0f ? -1.0f : y);
 }
 
-/*! Quaternion conjugate
+/*! Encode a unit vector in 32 bits (16-bit octahedral x and y)
  *
- *  @param[in] q Quaternion
+ *  The decoded vector is within 0.004 degrees of the original.
  *
- *  @returns conjugate of q
+ *  @param[in] n Unit vector
+ *
+ *  @returns x in the low half, y in the high half
  */
-static inline quat
-quatConjugate(quat q)
+static inline u32
+vec3fToOct32(vec3f n)
 {
-  return (quat){ q.r, -q.i, -q.j, -q.k };
+  float x, y;
+
+  octEncode(n, &x, &y);
+
+  return (u32)(octQuantize(x, 32767.0f) & 0xFFFF) | (u32)(octQuantize(y, 32767.0f) & 0xFFFF) << 16;
 }
 
-/*! Quaternion inverse
+/*! Decode a unit vector encoded by vec3fToOct32
  *
- *  @param[in] q Quaternion
+ *  @param[in] o Encoded vector
+ *
+ *  @returns unit vector
+ */
+static inline vec3f
+oct32ToVec3f(u32 o)
+{
+  float x = (s16)(o & 0xFFFF) / 32767.0f;
+  float y = (s16)(o >> 16)    / 32767.0f;
+
+  return octDecode(x < -1.0f ? -1.0f : x, y < -1.0f ? -1.0f : y);
+}
+
+/*! Release every allocation from an arena in O(1)
+ *
+ *  @param[in,out] a Arena
+ */
+static inline void
+arenaReset(arena *a)
+{
+  a->used = 0;
+}
+
+/*! Get the writer's buffer of a triple buffer
+ *
+ *  After a publish this holds an older frame, so write every element.
+ *
+ *  @param[in] tb Triple buffer
+ *
+ *  @returns buffer to fill
+ */
+static inline void*
+tripleBufferWriteBuffer(tripleBuffer *tb)
+{
+  return tb->buffer[tb->write];
+}
+
+/*! Convert a float to the PICA200's float24 format
+ *
+ *  float24 has a sign bit, a 7-bit exponent biased by 63 and a 16-bit
+ *  mantissa. The mantissa is truncated, values too small for a normal
+ *  float24 become signed zero, values too large become infinity and NaN
+ *  becomes 0x7FFFFF.
+ *
+ *  @param[in] f Value
+ *
+ *  @returns float24 bits
+ */
+static inline u32
+floatToF24(float f)
+{
+  union { float f; u32 u; } bits = { f };
+  u32 v    = bits.u;
+  u32 sign = (v >> 8) & 0x800000;
+  s32 exp  = (s32)((v >> 23) & 0xFF) - 64;
+  u32 man  = (v >> 7) & 0xFFFF;
+
+  if((v & 0x7FFFFFFF) > 0x7F800000)
+    return 0x7FFFFF;
+  if(exp <= 0)
+    return sign;
+  if(exp >= 0x7F)
+    return sign | 0x7F0000;
+
+  return sign | (u32)exp << 16 | man;
+}
+
+/*! Initialize a quaternion
+ *
+ *  @param[out] q Quaternion
+ */
+static inline void
+quatIdentity(quat *q)
+{
+  q->r = 1.0f;
+  q->i = q->j = q->k = 0.0f;
+}
+
+/*! Negate a quaternion component-wise
+ *
+ *  @param[in] q Quaternion
+ *
+ *  @returns negated q
+ */
+static inline quat
+quatNegate(quat q)
+{
+  return (quat){ -q.r, -q.i, -q.j, -q.k };
+}
+
+/*! Add two quaternions component-wise
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs+rhs
+ */
+static inline quat
+quatAdd(quat lhs, quat rhs)
+{
+  return (quat){ lhs.r + rhs.r,
+                 lhs.i + rhs.i,
+                 lhs.j + rhs.j,
+                 lhs.k + rhs.k };
+}
+
+/*! Subtract two quaternions component-wise
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs-rhs
+ */
+static inline quat
+quatSubtract(quat lhs, quat rhs)
+{
+  return (quat){ lhs.r - rhs.r,
+                 lhs.i - rhs.i,
+                 lhs.j - rhs.j,
+                 lhs.k - rhs.k };
+}
+
+/*! Scale a quaternion component-wise
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs+rhs
+ */
+static inline quat
+quatScale(quat q, float s)
+{
+  return (quat){ q.r*s, q.i*s, q.j*s, q.k*s };
+}
+
+/*! Normaliaze a quaternion
+ *
+ *  @param[in] q Quaternion
+ *
+ *  @returns normalized q
+ */
+static inline quat
+quatNormalize(quat q)
+{
+  float len = sqrtf(q.r*q.r + q.i*q.i + q.j*q.j + q.k*q.k);
+
+  return (quat){ q.r/len, q.i/len, q.j/len, q.k/len };
+}
+
+/*! Quaternion dot-product
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs . rhs
+ */
+static inline float
+quatDot(quat lhs, quat rhs)
+{
+  return lhs.r*rhs.r
+       + lhs.i*rhs.i
+       + lhs.j*rhs.j
+       + lhs.k*rhs.k;
+}
+
+/*! Quaternion conjugate
+ *
+ *  @param[in] q Quaternion
+ *
+ *  @returns conjugate of q
+ */
+static inline quat
+quatConjugate(quat q)
+{
+  return (quat){ q.r, -q.i, -q.j, -q.k };
+}
+
+/*! Quaternion inverse
+ *
+ *  @param[in] q Quaternion
  *
  *  @returns inverse of q
  */
@@ -424,100 +1117,1858 @@ static inline quat quatRotateZ(quat q, float radians)
                  q.r*s + q.k*c };
 }
 
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/*! Fill in identity matrix
+/*! Quantize an angle to a rotation cache step
  *
- *  @param[out] m Result matrix
+ *  @param[in] c       Rotation cache
+ *  @param[in] radians Angle
+ *
+ *  @returns nearest step, wrapped to [0,steps)
  */
-void mtx44Identity(mtx44 *m);
+static inline u32
+rotationCacheStep(const rotationCache *c, float radians)
+{
+  float turns = radians * 0.15915494309189535f; /* 1/(2*pi) */
+  u32   step;
 
-/*! Multiply two mtx44's
+  turns -= floorf(turns);
+  step   = (u32)(turns * c->steps + 0.5f);
+
+  return step < c->steps ? step : 0;
+}
+
+/*! Look up a sine/cosine pair in a rotation cache
  *
- *  @param[out] m   Result matrix
- *  @param[in]  lhs Left side
- *  @param[in]  rhs Right side
+ *  @param[in] c    Rotation cache
+ *  @param[in] half Angle in half steps (2*step for a step's full angle)
+ *
+ *  @returns sine followed by cosine
  */
-void mtx44Multiply(mtx44 *m, const mtx44 *lhs, const mtx44 *rhs);
+static inline const float*
+rotationCacheSinCos(const rotationCache *c, u32 half)
+{
+  return &c->table[2 * (half % (2 * c->steps))];
+}
 
-/*! Apply translation to a matrix
+/*! Rotate a quaternion about the X-axis by a cached angle
  *
- *  @param[in,out] m Matrix to transform
- *  @param[in]     x X-translation
- *  @param[in]     y Y-translation
- *  @param[in]     z Z-translation
+ *  @param[in] c    Rotation cache
+ *  @param[in] q    Quaternion
+ *  @param[in] step Angle in steps
+ *
+ *  @returns transformed quaternion
  */
-void mtx44Translate(mtx44 *m, float x, float y, float z);
+static inline quat
+quatRotateXCached(const rotationCache *c, quat q, u32 step)
+{
+  const float *sc = rotationCacheSinCos(c, step % c->steps);
+  float s = sc[0], co = sc[1];
 
-/*! Apply rotation to a matrix
+  return (quat){ q.r*co - q.i*s,
+                 q.r*s + q.i*co,
+                 q.j*co + q.k*s,
+                 q.k*co - q.j*s };
+}
+
+/*! Rotate a quaternion about the Y-axis by a cached angle
  *
- *  @param[in,out] m    Matrix to transform
- *  @param[in]     axis Axis to rotate about
- *  @param[in]     r    Angle to rotate (in radians)
+ *  @param[in] c    Rotation cache
+ *  @param[in] q    Quaternion
+ *  @param[in] step Angle in steps
+ *
+ *  @returns transformed quaternion
  */
-void mtx44Rotate(mtx44 *m, vec3f axis, float r);
+static inline quat
+quatRotateYCached(const rotationCache *c, quat q, u32 step)
+{
+  const float *sc = rotationCacheSinCos(c, step % c->steps);
+  float s = sc[0], co = sc[1];
 
-/*! Apply rotation to a matrix about the X-Axis
+  return (quat){ q.r*co - q.j*s,
+                 q.i*co - q.k*s,
+                 q.r*s + q.j*co,
+                 q.k*co + q.i*s };
+}
+
+/*! Rotate a quaternion about the Z-axis by a cached angle
  *
- *  @param[in,out] m Matrix to transform
- *  @param[in]     r Angle to rotate (in radians)
+ *  @param[in] c    Rotation cache
+ *  @param[in] q    Quaternion
+ *  @param[in] step Angle in steps
+ *
+ *  @returns transformed quaternion
  */
-void mtx44RotateX(mtx44 *m, float r);
+static inline quat
+quatRotateZCached(const rotationCache *c, quat q, u32 step)
+{
+  const float *sc = rotationCacheSinCos(c, step % c->steps);
+  float s = sc[0], co = sc[1];
 
-/*! Apply rotation to a matrix about the Y-Axis
+  return (quat){ q.r*co - q.k*s,
+                 q.i*co + q.j*s,
+                 q.j*co - q.i*s,
+                 q.r*s + q.k*co };
+}
+
+/*! Convert a bone transform into a 4x4 matrix
  *
- *  @param[in,out] m Matrix to transform
- *  @param[in]     r Angle to rotate (in radians)
+ *  @param[out] m Result matrix
+ *  @param[in]  b Bone transform
  */
-void mtx44RotateY(mtx44 *m, float r);
+static inline void
+boneTransformToMtx44(mtx44 *m, const boneTransform *b)
+{
+  quat  q = b->rotation;
+  vec3f s = b->scale;
 
-/*! Apply rotation to a matrix about the Z-Axis
+  float ii = q.i*q.i, ij = q.i*q.j, ik = q.i*q.k;
+  float jj = q.j*q.j, jk = q.j*q.k, kk = q.k*q.k;
+  float ri = q.r*q.i, rj = q.r*q.j, rk = q.r*q.k;
+
+  m->v[0*4+0] = s.x * (1.0f - 2.0f*(jj + kk));
+  m->v[0*4+1] = s.x * 2.0f*(ij + rk);
+  m->v[0*4+2] = s.x * 2.0f*(ik - rj);
+  m->v[0*4+3] = 0.0f;
+
+  m->v[1*4+0] = s.y * 2.0f*(ij - rk);
+  m->v[1*4+1] = s.y * (1.0f - 2.0f*(ii + kk));
+  m->v[1*4+2] = s.y * 2.0f*(jk + ri);
+  m->v[1*4+3] = 0.0f;
+
+  m->v[2*4+0] = s.z * 2.0f*(ik + rj);
+  m->v[2*4+1] = s.z * 2.0f*(jk - ri);
+  m->v[2*4+2] = s.z * (1.0f - 2.0f*(ii + jj));
+  m->v[2*4+3] = 0.0f;
+
+  m->v[3*4+0] = b->translation.x;
+  m->v[3*4+1] = b->translation.y;
+  m->v[3*4+2] = b->translation.z;
+  m->v[3*4+3] = 1.0f;
+}
+
+/*! Multiply two affine mtx44's
  *
- *  @param[in,out] m Matrix to transform
- *  @param[in]     r Angle to rotate (in radians)
+ *  The bottom rows are taken to be (0, 0, 0, 1) and not read.
+ *
+ *  @param[out] m   Result matrix (must not alias lhs or rhs)
+ *  @param[in]  lhs Left-hand side
+ *  @param[in]  rhs Right-hand side
  */
-void mtx44RotateZ(mtx44 *m, float r);
+static inline void
+mtx44MultiplyAffine(mtx44 *m, const mtx44 *lhs, const mtx44 *rhs)
+{
+  int i, j;
 
-/*! Apply scale to a matrix
+  for(i = 0; i < 4; ++i)
+  {
+    for(j = 0; j < 3; ++j)
+    {
+      m->v[i*4+j] = lhs->v[0*4+j]*rhs->v[i*4+0]
+                  + lhs->v[1*4+j]*rhs->v[i*4+1]
+                  + lhs->v[2*4+j]*rhs->v[i*4+2];
+    }
+
+    m->v[i*4+3] = 0.0f;
+  }
+
+  for(j = 0; j < 3; ++j)
+    m->v[3*4+j] += lhs->v[3*4+j];
+
+  m->v[3*4+3] = 1.0f;
+}
+
+/*! Measure how far a matrix's upper 3x3 is from orthonormal
  *
- *  @param[in,out] m Matrix to transform
- *  @param[in]     x X-scale
- *  @param[in]     y Y-scale
- *  @param[in]     z Z-scale
+ *  @param[in] m Matrix
+ *
+ *  @returns largest |c_i . c_j - delta_ij| over its first three columns
  */
-void mtx44Scale(mtx44 *m, float x, float y, float z);
+static inline float
+mtx44OrthonormalDrift(const mtx44 *m)
+{
+  vec3f x = { m->v[0*4+0], m->v[0*4+1], m->v[0*4+2] };
+  vec3f y = { m->v[1*4+0], m->v[1*4+1], m->v[1*4+2] };
+  vec3f z = { m->v[2*4+0], m->v[2*4+1], m->v[2*4+2] };
 
-/*! Fill in a perspective projection matrix
+  float e[6] = { vec3fDot(x, x) - 1.0f, vec3fDot(y, y) - 1.0f, vec3fDot(z, z) - 1.0f,
+                 vec3fDot(x, y),        vec3fDot(y, z),        vec3fDot(z, x) };
+  float drift = 0.0f;
+  int   i;
+
+  for(i = 0; i < 6; ++i)
+    drift = fabsf(e[i]) > drift ? fabsf(e[i]) : drift;
+
+  return drift;
+}
+
+/*! Cubic from Bezier control points
  *
- *  @param[out] m      Result matrix
- *  @param[in]  fovy   Field-of-view angle (in radians), in the Y-direction
- *  @param[in]  aspect Aspect ratio (y/x)
- *  @param[in]  near   Near clipping plane
- *  @param[in]  far    Far clipping plane
+ *  @param[in] p0 Start point
+ *  @param[in] p1 First control point
+ *  @param[in] p2 Second control point
+ *  @param[in] p3 End point
+ *
+ *  @returns curve from p0 (t = 0) to p3 (t = 1)
  */
-void mtx44Perpective(mtx44 *m, float fovy, float aspect, float near, float far);
+static inline cubic
+cubicFromBezier(vec3f p0, vec3f p1, vec3f p2, vec3f p3)
+{
+  return (cubic){ (vec3f){ 3.0f*(p1.x - p2.x) + p3.x - p0.x,
+                           3.0f*(p1.y - p2.y) + p3.y - p0.y,
+                           3.0f*(p1.z - p2.z) + p3.z - p0.z },
+                  (vec3f){ 3.0f*(p0.x - 2.0f*p1.x + p2.x),
+                           3.0f*(p0.y - 2.0f*p1.y + p2.y),
+                           3.0f*(p0.z - 2.0f*p1.z + p2.z) },
+                  (vec3f){ 3.0f*(p1.x - p0.x),
+                           3.0f*(p1.y - p0.y),
+                           3.0f*(p1.z - p0.z) },
+                  p0 };
+}
 
-/*! Fill in an orthogonal projection matrix
+/*! Cubic from uniform Catmull-Rom control points
  *
- *  @param[out] m      Result matrix
- *  @param[in]  left   Left vertical clipping plane
- *  @param[in]  right  Right vertical clipping plane
- *  @param[in]  bottom Bottom horizontal clipping plane
- *  @param[in]  top    Top horizontal clipping plane
- *  @param[in]  near   Near depth clipping plane
- *  @param[in]  far    Far depth clipping plane
+ *  @param[in] p0 Point before the segment
+ *  @param[in] p1 Start point
+ *  @param[in] p2 End point
+ *  @param[in] p3 Point after the segment
+ *
+ *  @returns curve from p1 (t = 0) to p2 (t = 1)
  */
-void mtx44Ortho(mtx44 *m, float left, float right, float bottom, float top, float near, float far);
+static inline cubic
+cubicFromCatmullRom(vec3f p0, vec3f p1, vec3f p2, vec3f p3)
+{
+  return (cubic){ (vec3f){ 0.5f*(3.0f*(p1.x - p2.x) + p3.x - p0.x),
+                           0.5f*(3.0f*(p1.y - p2.y) + p3.y - p0.y),
+                           0.5f*(3.0f*(p1.z - p2.z) + p3.z - p0.z) },
+                  (vec3f){ p0.x - 2.5f*p1.x + 2.0f*p2.x - 0.5f*p3.x,
+                           p0.y - 2.5f*p1.y + 2.0f*p2.y - 0.5f*p3.y,
+                           p0.z - 2.5f*p1.z + 2.0f*p2.z - 0.5f*p3.z },
+                  (vec3f){ 0.5f*(p2.x - p0.x),
+                           0.5f*(p2.y - p0.y),
+                           0.5f*(p2.z - p0.z) },
+                  p1 };
+}
 
-/*! Convert a quaternion into a 4x4 matrix
+/*! Cubic from Hermite end points and tangents
+ *
+ *  @param[in] p0 Start point
+ *  @param[in] m0 Tangent at p0
+ *  @param[in] p1 End point
+ *  @param[in] m1 Tangent at p1
+ *
+ *  @returns curve from p0 (t = 0) to p1 (t = 1)
+ */
+static inline cubic
+cubicFromHermite(vec3f p0, vec3f m0, vec3f p1, vec3f m1)
+{
+  return (cubic){ (vec3f){ 2.0f*(p0.x - p1.x) + m0.x + m1.x,
+                           2.0f*(p0.y - p1.y) + m0.y + m1.y,
+                           2.0f*(p0.z - p1.z) + m0.z + m1.z },
+                  (vec3f){ 3.0f*(p1.x - p0.x) - 2.0f*m0.x - m1.x,
+                           3.0f*(p1.y - p0.y) - 2.0f*m0.y - m1.y,
+                           3.0f*(p1.z - p0.z) - 2.0f*m0.z - m1.z },
+                  m0,
+                  p0 };
+}
+
+/*! Evaluate a cubic
+ *
+ *  @param[in] c Curve
+ *  @param[in] t Parameter
+ *
+ *  @returns point at t
+ */
+static inline vec3f
+cubicEvaluate(const cubic *c, float t)
+{
+  return (vec3f){ ((c->a.x*t + c->b.x)*t + c->c.x)*t + c->d.x,
+                  ((c->a.y*t + c->b.y)*t + c->c.y)*t + c->d.y,
+                  ((c->a.z*t + c->b.z)*t + c->c.z)*t + c->d.z };
+}
+
+/*! Evaluate a cubic's derivative
+ *
+ *  @param[in] c Curve
+ *  @param[in] t Parameter
+ *
+ *  @returns tangent (not normalized) at t
+ */
+static inline vec3f
+cubicTangent(const cubic *c, float t)
+{
+  return (vec3f){ (3.0f*c->a.x*t + 2.0f*c->b.x)*t + c->c.x,
+                  (3.0f*c->a.y*t + 2.0f*c->b.y)*t + c->c.y,
+                  (3.0f*c->a.z*t + 2.0f*c->b.z)*t + c->c.z };
+}
+
+/*! Start forward differencing a cubic at t = 0
+ *
+ *  Each cubicForwardStep then advances t by h using three additions per
+ *  component. Rounding error grows with the number of steps (roughly
+ *  cubically), so restart from an exact point every few hundred steps if
+ *  that matters.
+ *
+ *  @param[out] fd State
+ *  @param[in]  c  Curve
+ *  @param[in]  h  Parameter step
+ */
+static inline void
+cubicForwardInit(cubicForward *fd, const cubic *c, float h)
+{
+  float h2 = h*h, h3 = h2*h;
+
+  fd->p  = c->d;
+  fd->d1 = (vec3f){ c->a.x*h3 + c->b.x*h2 + c->c.x*h,
+                    c->a.y*h3 + c->b.y*h2 + c->c.y*h,
+                    c->a.z*h3 + c->b.z*h2 + c->c.z*h };
+  fd->d2 = (vec3f){ 6.0f*c->a.x*h3 + 2.0f*c->b.x*h2,
+                    6.0f*c->a.y*h3 + 2.0f*c->b.y*h2,
+                    6.0f*c->a.z*h3 + 2.0f*c->b.z*h2 };
+  fd->d3 = vec3fScale(c->a, 6.0f*h3);
+}
+
+/*! Advance forward differencing by one step
+ *
+ *  @param[in,out] fd State
+ *
+ *  @returns the new current point
+ */
+static inline vec3f
+cubicForwardStep(cubicForward *fd)
+{
+  fd->p  = vec3fAdd(fd->p,  fd->d1);
+  fd->d1 = vec3fAdd(fd->d1, fd->d2);
+  fd->d2 = vec3fAdd(fd->d2, fd->d3);
+
+  return fd->p;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Add arrays of vec3i's component-wise
+ *
+ *  @param[out] out   Result (may alias lhs or rhs)
+ *  @param[in]  lhs   Left sides
+ *  @param[in]  rhs   Right sides
+ *  @param[in]  count Number of vectors
+ */
+void vec3iAddBatch(vec3i *out, const vec3i *lhs, const vec3i *rhs, size_t count);
+
+/*! Subtract arrays of vec3i's component-wise
+ *
+ *  @param[out] out   Result (may alias lhs or rhs)
+ *  @param[in]  lhs   Left sides
+ *  @param[in]  rhs   Right sides
+ *  @param[in]  count Number of vectors
+ */
+void vec3iSubtractBatch(vec3i *out, const vec3i *lhs, const vec3i *rhs, size_t count);
+
+/*! Scale an array of vec3i's component-wise
+ *
+ *  @param[out] out   Result (may alias v)
+ *  @param[in]  v     Vectors
+ *  @param[in]  s     Scale
+ *  @param[in]  count Number of vectors
+ */
+void vec3iScaleBatch(vec3i *out, const vec3i *v, s32 s, size_t count);
+
+/*! Cross arrays of vec3i's
+ *
+ *  @param[out] out   Result (may alias lhs or rhs)
+ *  @param[in]  lhs   Left sides
+ *  @param[in]  rhs   Right sides
+ *  @param[in]  count Number of vectors
+ */
+void vec3iCrossBatch(vec3i *out, const vec3i *lhs, const vec3i *rhs, size_t count);
+
+/*! Encode an array of vec3i's as Morton codes
+ *
+ *  @see vec3iToMorton
+ *
+ *  @param[out] codes Morton codes
+ *  @param[in]  v     Vectors
+ *  @param[in]  count Number of vectors
+ */
+void vec3iToMortonBatch(u64 *codes, const vec3i *v, size_t count);
+
+/*! Decode an array of Morton codes to vec3i's
+ *
+ *  @param[out] v     Vectors
+ *  @param[in]  codes Morton codes
+ *  @param[in]  count Number of codes
+ */
+void mortonToVec3iBatch(vec3i *v, const u64 *codes, size_t count);
+
+/*! Fill in identity matrix
+ *
+ *  @param[out] m Result matrix
+ */
+void mtx44Identity(mtx44 *m);
+
+/*! Multiply two mtx44's
+ *
+ *  @param[out] m   Result matrix
+ *  @param[in]  lhs Left side
+ *  @param[in]  rhs Right side
+ */
+void mtx44Multiply(mtx44 *m, const mtx44 *lhs, const mtx44 *rhs);
+
+/*! Apply translation to a matrix
+ *
+ *  @param[in,out] m Matrix to transform
+ *  @param[in]     x X-translation
+ *  @param[in]     y Y-translation
+ *  @param[in]     z Z-translation
+ */
+void mtx44Translate(mtx44 *m, float x, float y, float z);
+
+/*! Apply rotation to a matrix
+ *
+ *  @param[in,out] m    Matrix to transform
+ *  @param[in]     axis Axis to rotate about
+ *  @param[in]     r    Angle to rotate (in radians)
+ */
+void mtx44Rotate(mtx44 *m, vec3f axis, float r);
+
+/*! Apply rotation to a matrix about the X-Axis
+ *
+ *  @param[in,out] m Matrix to transform
+ *  @param[in]     r Angle to rotate (in radians)
+ */
+void mtx44RotateX(mtx44 *m, float r);
+
+/*! Apply rotation to a matrix about the Y-Axis
+ *
+ *  @param[in,out] m Matrix to transform
+ *  @param[in]     r Angle to rotate (in radians)
+ */
+void mtx44RotateY(mtx44 *m, float r);
+
+/*! Apply rotation to a matrix about the Z-Axis
+ *
+ *  @param[in,out] m Matrix to transform
+ *  @param[in]     r Angle to rotate (in radians)
+ */
+void mtx44RotateZ(mtx44 *m, float r);
+
+/*! Apply scale to a matrix
+ *
+ *  @param[in,out] m Matrix to transform
+ *  @param[in]     x X-scale
+ *  @param[in]     y Y-scale
+ *  @param[in]     z Z-scale
+ */
+void mtx44Scale(mtx44 *m, float x, float y, float z);
+
+/*! Allocate a rotation cache's sine/cosine table
+ *
+ *  @param[out] c     Rotation cache
+ *  @param[in]  steps Steps per turn
+ *
+ *  @returns whether the table was allocated
+ */
+int rotationCacheInit(rotationCache *c, u32 steps);
+
+/*! Free a rotation cache's table
+ *
+ *  @param[in,out] c Rotation cache
+ */
+void rotationCacheFree(rotationCache *c);
+
+/*! Get the 3x3 block of a rotation about an arbitrary axis
+ *
+ *  Blocks are kept per (axis, step) in a least-recently-used set of
+ *  ROTATION_CACHE_AXES entries; the axis must match bit for bit to hit.
+ *  The cache is updated, so it must not be shared between threads.
+ *
+ *  @param[in,out] c    Rotation cache
+ *  @param[in]     axis Axis to rotate about
+ *  @param[in]     step Angle in steps
+ *
+ *  @returns rotation block, valid until the next lookup
+ */
+const float* rotationCacheLookup(rotationCache *c, vec3f axis, u32 step);
+
+/*! Apply a cached rotation to a matrix
+ *
+ *  @param[in,out] m    Matrix to transform
+ *  @param[in,out] c    Rotation cache
+ *  @param[in]     axis Axis to rotate about
+ *  @param[in]     step Angle in steps
+ */
+void mtx44RotateCached(mtx44 *m, rotationCache *c, vec3f axis, u32 step);
+
+/*! Apply a cached rotation to a matrix about the X-Axis
+ *
+ *  @param[in,out] m    Matrix to transform
+ *  @param[in]     c    Rotation cache
+ *  @param[in]     step Angle in steps
+ */
+void mtx44RotateXCached(mtx44 *m, const rotationCache *c, u32 step);
+
+/*! Apply a cached rotation to a matrix about the Y-Axis
+ *
+ *  @param[in,out] m    Matrix to transform
+ *  @param[in]     c    Rotation cache
+ *  @param[in]     step Angle in steps
+ */
+void mtx44RotateYCached(mtx44 *m, const rotationCache *c, u32 step);
+
+/*! Apply a cached rotation to a matrix about the Z-Axis
+ *
+ *  @param[in,out] m    Matrix to transform
+ *  @param[in]     c    Rotation cache
+ *  @param[in]     step Angle in steps
+ */
+void mtx44RotateZCached(mtx44 *m, const rotationCache *c, u32 step);
+
+/*! Fill in a perspective projection matrix
+ *
+ *  @param[out] m      Result matrix
+ *  @param[in]  fovy   Field-of-view angle (in radians), in the Y-direction
+ *  @param[in]  aspect Aspect ratio (y/x)
+ *  @param[in]  near   Near clipping plane
+ *  @param[in]  far    Far clipping plane
+ */
+void mtx44Perpective(mtx44 *m, float fovy, float aspect, float near, float far);
+
+/*! Fill in an orthogonal projection matrix
+ *
+ *  @param[out] m      Result matrix
+ *  @param[in]  left   Left vertical clipping plane
+ *  @param[in]  right  Right vertical clipping plane
+ *  @param[in]  bottom Bottom horizontal clipping plane
+ *  @param[in]  top    Top horizontal clipping plane
+ *  @param[in]  near   Near depth clipping plane
+ *  @param[in]  far    Far depth clipping plane
+ */
+void mtx44Ortho(mtx44 *m, float left, float right, float bottom, float top, float near, float far);
+
+/*! Fill in a look-at view matrix
+ *
+ *  @param[out] m      Result matrix
+ *  @param[in]  eye    Eye position
+ *  @param[in]  target Point to look at
+ *  @param[in]  up     Up direction
+ */
+void mtx44LookAt(mtx44 *m, vec3f eye, vec3f target, vec3f up);
+
+/*! Invert a mtx44
+ *
+ *  @param[out] out Result matrix (may alias m)
+ *  @param[in]  m   Matrix to invert
+ *
+ *  @returns whether m is invertible; out is untouched if not
+ */
+int mtx44Inverse(mtx44 *out, const mtx44 *m);
+
+/*! Extract the frustum planes of a view-projection matrix
+ *
+ *  Planes are left, right, bottom, top, near, far, with unit normals
+ *  pointing inwards: a point p is inside a plane if
+ *  x*p.x + y*p.y + z*p.z + w >= 0.
+ *
+ *  @param[out] planes Frustum planes
+ *  @param[in]  m      View-projection matrix
+ */
+void mtx44FrustumPlanes(vec4f planes[6], const mtx44 *m);
+
+/*! Convert a quaternion into a 4x4 matrix
  *
  *  @param[out] m Result matrix
  *  @param[in]  q Quaternion
  */
 void quatToMtx44(mtx44 *m, quat q);
 
+/*! Transform an array of padded points by an affine matrix
+ *
+ *  The w-component of the input is ignored and the output's is 1.
+ *
+ *  @param[out] out   Transformed points (may alias in)
+ *  @param[in]  m     Affine transform
+ *  @param[in]  in    Points
+ *  @param[in]  count Number of points
+ */
+void mtx44TransformVec4fBatch(vec4f *out, const mtx44 *m, const vec4f *in, size_t count);
+
+/*! Convert an array of vec3f to padded vec4f
+ *
+ *  @param[out] out   Padded vectors
+ *  @param[in]  in    Vectors
+ *  @param[in]  w     w-component
+ *  @param[in]  count Number of vectors
+ */
+void vec3fToVec4fBatch(vec4f *out, const vec3f *in, float w, size_t count);
+
+/*! Convert an array of padded vec4f to vec3f
+ *
+ *  @param[out] out   Vectors
+ *  @param[in]  in    Padded vectors
+ *  @param[in]  count Number of vectors
+ */
+void vec4fToVec3fBatch(vec3f *out, const vec4f *in, size_t count);
+
+/*! Encode an array of unit vectors in 16 bits each
+ *
+ *  @param[out] out   Encoded vectors
+ *  @param[in]  in    Unit vectors
+ *  @param[in]  count Number of vectors
+ */
+void vec3fToOct16Batch(u16 *out, const vec3f *in, size_t count);
+
+/*! Decode an array of 16-bit octahedral unit vectors
+ *
+ *  @param[out] out   Unit vectors
+ *  @param[in]  in    Encoded vectors
+ *  @param[in]  count Number of vectors
+ */
+void oct16ToVec3fBatch(vec3f *out, const u16 *in, size_t count);
+
+/*! Encode an array of unit vectors in 32 bits each
+ *
+ *  @param[out] out   Encoded vectors
+ *  @param[in]  in    Unit vectors
+ *  @param[in]  count Number of vectors
+ */
+void vec3fToOct32Batch(u32 *out, const vec3f *in, size_t count);
+
+/*! Decode an array of 32-bit octahedral unit vectors
+ *
+ *  @param[out] out   Unit vectors
+ *  @param[in]  in    Encoded vectors
+ *  @param[in]  count Number of vectors
+ */
+void oct32ToVec3fBatch(vec3f *out, const u32 *in, size_t count);
+
+/*! Allocate an arena's storage
+ *
+ *  @param[out] a    Arena
+ *  @param[in]  size Capacity in bytes
+ *
+ *  @returns whether the storage was allocated
+ */
+int arenaInit(arena *a, size_t size);
+
+/*! Free an arena's storage
+ *
+ *  @param[in,out] a Arena
+ */
+void arenaFree(arena *a);
+
+/*! Allocate from an arena
+ *
+ *  @param[in,out] a     Arena
+ *  @param[in]     size  Size in bytes
+ *  @param[in]     align Alignment (power of two, at most 64)
+ *
+ *  @returns allocation, or NULL if the arena is full
+ */
+void* arenaAlloc(arena *a, size_t size, size_t align);
+
+/*! Allocate a cache-line aligned mtx44 array from an arena
+ *
+ *  @param[in,out] a     Arena
+ *  @param[in]     count Number of matrices
+ *
+ *  @returns array, or NULL if the arena is full
+ */
+static inline mtx44a*
+arenaAllocMtx44(arena *a, size_t count)
+{
+  return (mtx44a*)arenaAlloc(a, count * sizeof(mtx44a), 64);
+}
+
+/*! Allocate a 16-byte aligned quat array from an arena
+ *
+ *  @param[in,out] a     Arena
+ *  @param[in]     count Number of quaternions
+ *
+ *  @returns array, or NULL if the arena is full
+ */
+static inline quata*
+arenaAllocQuat(arena *a, size_t count)
+{
+  return (quata*)arenaAlloc(a, count * sizeof(quata), 16);
+}
+
+/*! Allocate a 16-byte aligned vec4f array from an arena
+ *
+ *  @param[in,out] a     Arena
+ *  @param[in]     count Number of vectors
+ *
+ *  @returns array, or NULL if the arena is full
+ */
+static inline vec4f*
+arenaAllocVec4f(arena *a, size_t count)
+{
+  return (vec4f*)arenaAlloc(a, count * sizeof(vec4f), 16);
+}
+
+/*! Allocate a triple buffer's storage
+ *
+ *  @param[out] tb   Triple buffer
+ *  @param[in]  size Bytes per buffer
+ *
+ *  @returns whether the storage was allocated
+ */
+int tripleBufferInit(tripleBuffer *tb, size_t size);
+
+/*! Free a triple buffer's storage
+ *
+ *  @param[in,out] tb Triple buffer
+ */
+void tripleBufferFree(tripleBuffer *tb);
+
+/*! Publish the writer's buffer (writer thread only)
+ *
+ *  @param[in,out] tb Triple buffer
+ *
+ *  @returns frame number of the published buffer (starting at 1)
+ */
+u64 tripleBufferPublish(tripleBuffer *tb);
+
+/*! Get the latest published buffer (reader thread only)
+ *
+ *  The buffer stays valid and unchanged until the next call.
+ *
+ *  @param[in,out] tb    Triple buffer
+ *  @param[out]    frame Frame number of the buffer, 0 if nothing has been
+ *                       published yet (may be NULL)
+ *
+ *  @returns latest buffer
+ */
+const void* tripleBufferAcquire(tripleBuffer *tb, u64 *frame);
+
+/*! Write mtx44's in the PICA200 float32 uniform layout
+ *
+ *  Each matrix fills four uniform registers, one per row, with the
+ *  components of each row in w, z, y, x order: 16 words per matrix.
+ *
+ *  @param[out] out   Uniform data
+ *  @param[in]  m     Matrices
+ *  @param[in]  count Number of matrices
+ */
+void mtx44ToPicaF32(u32 *out, const mtx44 *m, size_t count);
+
+/*! Write mtx44's in the PICA200 packed float24 uniform layout
+ *
+ *  Each matrix fills four uniform registers, one per row, as four float24
+ *  values packed into three words: 12 words per matrix.
+ *
+ *  @param[out] out   Uniform data
+ *  @param[in]  m     Matrices
+ *  @param[in]  count Number of matrices
+ */
+void mtx44ToPicaF24(u32 *out, const mtx44 *m, size_t count);
+
+/*! Write GPU commands uploading mtx44's to float uniform registers
+ *
+ *  The commands select the first register and then stream the uniform data
+ *  (see mtx44ToPicaF32/mtx44ToPicaF24) straight into the command buffer.
+ *
+ *  @param[out] cmd      Command buffer (NULL to only compute the size)
+ *  @param[in]  m        Matrices
+ *  @param[in]  count    Number of matrices
+ *  @param[in]  reg      First uniform register
+ *  @param[in]  f24      Whether to upload packed float24 rather than float32
+ *  @param[in]  geometry Whether to target the geometry shader rather than
+ *                       the vertex shader
+ *
+ *  @returns number of command words (always even)
+ */
+size_t mtx44ToPicaCommands(u32 *cmd, const mtx44 *m, size_t count, u32 reg, int f24, int geometry);
+
+/*! Compute the normal matrix (inverse-transpose of the upper 3x3)
+ *
+ *  Computed from the cofactors directly, so the determinant's sign and
+ *  scale are included. The result's translation is zero and its bottom row
+ *  is (0, 0, 0, 1). If m is singular, the unscaled cofactor matrix is
+ *  returned.
+ *
+ *  @param[out] out Normal matrix
+ *  @param[in]  m   Model-view matrix
+ */
+void mtx44NormalMatrix(mtx44 *out, const mtx44 *m);
+
+/*! Compute the normal matrix of a rotation with uniform scale
+ *
+ *  For m = s*R the normal matrix is R/s = m/s^2, so this only needs the
+ *  length of one column. The result is wrong for non-uniform scale or
+ *  shear.
+ *
+ *  @param[out] out Normal matrix
+ *  @param[in]  m   Model-view matrix
+ */
+void mtx44NormalMatrixUniform(mtx44 *out, const mtx44 *m);
+
+/*! Compute normal matrices of an array of matrices
+ *
+ *  @see mtx44NormalMatrix
+ *
+ *  @param[out] out   Normal matrices (may alias m)
+ *  @param[in]  m     Model-view matrices
+ *  @param[in]  count Number of matrices
+ */
+void mtx44NormalMatrixBatch(mtx44 *out, const mtx44 *m, size_t count);
+
+/*! Make a matrix's upper 3x3 a rotation again
+ *
+ *  The X and Y columns are normalized, the error in the angle between them
+ *  is split evenly, and Z is rebuilt as their cross-product. Translation is
+ *  kept; any scale is lost.
+ *
+ *  @param[in,out] m Matrix
+ */
+void mtx44Orthonormalize(mtx44 *m);
+
+/*! Orthonormalize an array of matrices
+ *
+ *  @see mtx44Orthonormalize
+ *
+ *  @param[in,out] m     Matrices
+ *  @param[in]     count Number of matrices
+ */
+void mtx44OrthonormalizeBatch(mtx44 *m, size_t count);
+
+/*! Orthonormalize the matrices of an array that have drifted too far
+ *
+ *  @see mtx44OrthonormalDrift
+ *
+ *  @param[in,out] m         Matrices
+ *  @param[in]     tolerance Drift that triggers orthonormalization
+ *  @param[in]     count     Number of matrices
+ *
+ *  @returns number of matrices orthonormalized
+ */
+size_t mtx44OrthonormalizeDriftBatch(mtx44 *m, float tolerance, size_t count);
+
+/*! Initialize a camera at the origin looking down -Z, with an identity
+ *  projection
+ *
+ *  @param[out] c Camera
+ */
+void cameraInit(camera *c);
+
+/*! Set a camera's view
+ *
+ *  @param[in,out] c      Camera
+ *  @param[in]     eye    Eye position
+ *  @param[in]     target Point to look at
+ *  @param[in]     up     Up direction
+ */
+void cameraLookAt(camera *c, vec3f eye, vec3f target, vec3f up);
+
+/*! Set a camera's perspective projection
+ *
+ *  @see mtx44Perpective
+ *
+ *  @param[in,out] c      Camera
+ *  @param[in]     fovy   Field-of-view angle (in radians), in the Y-direction
+ *  @param[in]     aspect Aspect ratio (y/x)
+ *  @param[in]     near   Near clipping plane
+ *  @param[in]     far    Far clipping plane
+ */
+void cameraPerspective(camera *c, float fovy, float aspect, float near, float far);
+
+/*! Set a camera's orthogonal projection
+ *
+ *  @see mtx44Ortho
+ *
+ *  @param[in,out] c      Camera
+ *  @param[in]     left   Left vertical clipping plane
+ *  @param[in]     right  Right vertical clipping plane
+ *  @param[in]     bottom Bottom horizontal clipping plane
+ *  @param[in]     top    Top horizontal clipping plane
+ *  @param[in]     near   Near depth clipping plane
+ *  @param[in]     far    Far depth clipping plane
+ */
+void cameraOrtho(camera *c, float left, float right, float bottom, float top, float near, float far);
+
+/*! Get a camera's view matrix
+ *
+ *  @param[in,out] c Camera
+ *
+ *  @returns view matrix
+ */
+const mtx44* cameraView(camera *c);
+
+/*! Get a camera's projection matrix
+ *
+ *  @param[in,out] c Camera
+ *
+ *  @returns projection matrix
+ */
+const mtx44* cameraProjection(camera *c);
+
+/*! Get a camera's view-projection matrix (projection * view)
+ *
+ *  @param[in,out] c Camera
+ *
+ *  @returns view-projection matrix
+ */
+const mtx44* cameraViewProjection(camera *c);
+
+/*! Get the inverse of a camera's view-projection matrix
+ *
+ *  @param[in,out] c Camera
+ *
+ *  @returns inverse view-projection matrix (identity if it is singular)
+ */
+const mtx44* cameraInverseViewProjection(camera *c);
+
+/*! Get a camera's frustum planes
+ *
+ *  @see mtx44FrustumPlanes
+ *
+ *  @param[in,out] c Camera
+ *
+ *  @returns six frustum planes
+ */
+const vec4f* cameraFrustum(camera *c);
+
+/*! Integrate orientations by angular velocity (exponential map)
+ *
+ *  Each q becomes exp(w*dt/2) * q, i.e. q rotated by |w|*dt about the
+ *  world-space axis w. This preserves the norm up to rounding, which is
+ *  accumulated in drift; a quaternion is renormalized (and its drift
+ *  cleared) only once its drift exceeds the tolerance.
+ *
+ *  @param[in,out] q         Orientations
+ *  @param[in]     w         Angular velocities (radians per unit time)
+ *  @param[in,out] drift     Bound on |1 - |q|^2| per orientation (start at 0)
+ *  @param[in]     dt        Time step
+ *  @param[in]     tolerance Drift that triggers renormalization
+ *  @param[in]     count     Number of orientations
+ *
+ *  @returns number of orientations renormalized
+ */
+size_t quatIntegrateBatch(quatSoA q, vec3fSoA w, float *drift, float dt, float tolerance, size_t count);
+
+/*! Integrate orientations by angular velocity (first order)
+ *
+ *  Each q becomes q + (dt/2) * (0, w) * q. This is cheaper than the
+ *  exponential map but grows |q|^2 by a factor of 1 + (|w|*dt/2)^2 every
+ *  step, which is tracked in drift as for quatIntegrateBatch.
+ *
+ *  @param[in,out] q         Orientations
+ *  @param[in]     w         Angular velocities (radians per unit time)
+ *  @param[in,out] drift     Bound on |1 - |q|^2| per orientation (start at 0)
+ *  @param[in]     dt        Time step
+ *  @param[in]     tolerance Drift that triggers renormalization
+ *  @param[in]     count     Number of orientations
+ *
+ *  @returns number of orientations renormalized
+ */
+size_t quatIntegrateLinearBatch(quatSoA q, vec3fSoA w, float *drift, float dt, float tolerance, size_t count);
+
+/*! Allocate a vec3f stream
+ *
+ *  The three component arrays share one block; each starts on a 64-byte
+ *  boundary.
+ *
+ *  @param[out] v     Stream
+ *  @param[in]  count Number of vectors
+ *
+ *  @returns whether the storage was allocated
+ */
+int vec3fSoAInit(vec3fSoA *v, size_t count);
+
+/*! Free a vec3f stream allocated by vec3fSoAInit
+ *
+ *  @param[in,out] v Stream
+ */
+void vec3fSoAFree(vec3fSoA *v);
+
+/*! Add a scaled vec3f stream to another: y += a*x
+ *
+ *  @param[in,out] y     Accumulated vectors
+ *  @param[in]     a     Scale
+ *  @param[in]     x     Added vectors
+ *  @param[in]     count Number of vectors
+ */
+void vec3fSoAAxpy(vec3fSoA y, float a, vec3fSoA x, size_t count);
+
+/*! Blend two vec3f streams: y = a*x + b*y
+ *
+ *  @param[in,out] y     Blended vectors
+ *  @param[in]     a     Scale of x
+ *  @param[in]     x     Vectors
+ *  @param[in]     b     Scale of y
+ *  @param[in]     count Number of vectors
+ */
+void vec3fSoAAxpby(vec3fSoA y, float a, vec3fSoA x, float b, size_t count);
+
+/*! Multiply-add vec3f streams component-wise: out = a*b + c
+ *
+ *  @param[out] out   Results (may alias any input)
+ *  @param[in]  a     Multiplicands
+ *  @param[in]  b     Multipliers
+ *  @param[in]  c     Addends
+ *  @param[in]  count Number of vectors
+ */
+void vec3fSoAFma(vec3fSoA out, vec3fSoA a, vec3fSoA b, vec3fSoA c, size_t count);
+
+/*! Clamp a vec3f stream component-wise
+ *
+ *  @param[in,out] v     Vectors
+ *  @param[in]     min   Lower bounds
+ *  @param[in]     max   Upper bounds
+ *  @param[in]     count Number of vectors
+ */
+void vec3fSoAClamp(vec3fSoA v, vec3f min, vec3f max, size_t count);
+
+/*! Dot-products of two vec3f streams
+ *
+ *  @param[out] out   Dot-products
+ *  @param[in]  a     Left sides
+ *  @param[in]  b     Right sides
+ *  @param[in]  count Number of vectors
+ */
+void vec3fSoADot(float *out, vec3fSoA a, vec3fSoA b, size_t count);
+
+/*! Lengths of a vec3f stream
+ *
+ *  @param[out] out   Lengths
+ *  @param[in]  v     Vectors
+ *  @param[in]  count Number of vectors
+ */
+void vec3fSoALength(float *out, vec3fSoA v, size_t count);
+
+/*! Normalize a vec3f stream; zero vectors stay zero
+ *
+ *  @param[in,out] v     Vectors
+ *  @param[in]     count Number of vectors
+ */
+void vec3fSoANormalize(vec3fSoA v, size_t count);
+
+/*! Integrate particles by one explicit Euler step
+ *
+ *  For each live particle, v = v*damping + accel*dt, then p += v*dt. Dead
+ *  particles are left untouched.
+ *
+ *  @param[in,out] p       Positions
+ *  @param[in,out] v       Velocities
+ *  @param[in]     accel   Acceleration shared by all particles
+ *  @param[in]     damping Velocity scale per step
+ *  @param[in]     dt      Time step
+ *  @param[in]     alive   Nonzero for live particles (NULL for all)
+ *  @param[in]     count   Number of particles
+ */
+void vec3fSoAIntegrate(vec3fSoA p, vec3fSoA v, vec3f accel, float damping, float dt, const u8 *alive, size_t count);
+
+/*! Remove dead elements from a vec3f stream, keeping order
+ *
+ *  Compact every stream of a particle system with the same mask before
+ *  updating the mask itself.
+ *
+ *  @param[in,out] v     Vectors
+ *  @param[in]     alive Nonzero for elements to keep
+ *  @param[in]     count Number of vectors
+ *
+ *  @returns number of vectors kept
+ */
+size_t vec3fSoACompact(vec3fSoA v, const u8 *alive, size_t count);
+
+/*! Multiply arrays of mtx44's
+ *
+ *  @param[out] m     Result matrices
+ *  @param[in]  lhs   Left sides
+ *  @param[in]  rhs   Right sides
+ *  @param[in]  count Number of matrices
+ */
+void mtx44MultiplyBatch(mtx44 *m, const mtx44 *lhs, const mtx44 *rhs, size_t count);
+
+/*! Transform an array of points by an affine matrix
+ *
+ *  @param[out] out   Transformed points (may alias in)
+ *  @param[in]  m     Affine transform
+ *  @param[in]  in    Points
+ *  @param[in]  count Number of points
+ */
+void mtx44TransformBatch(vec3f *out, const mtx44 *m, const vec3f *in, size_t count);
+
+/*! Multiply arrays of quaternions
+ *
+ *  @param[out] out   Results (may alias lhs or rhs)
+ *  @param[in]  lhs   Left sides
+ *  @param[in]  rhs   Right sides
+ *  @param[in]  count Number of quaternions
+ */
+void quatMultiplyBatch(quat *out, const quat *lhs, const quat *rhs, size_t count);
+
+/*! Convert an array of quaternions into 4x4 matrices
+ *
+ *  @param[out] m     Result matrices
+ *  @param[in]  q     Quaternions
+ *  @param[in]  count Number of quaternions
+ */
+void quatToMtx44Batch(mtx44 *m, const quat *q, size_t count);
+
+/*! Compute the bounding box of a set of points
+ *
+ *  An empty set produces an inverted box (min > max).
+ *
+ *  @param[out] box    Result box
+ *  @param[in]  points Points
+ *  @param[in]  count  Number of points
+ */
+void aabbFromPoints(aabb *box, const vec3f *points, size_t count);
+
+/*! Compute the bounding boxes of several point sets
+ *
+ *  Point set i is points[offsets[i]] through points[offsets[i+1]-1].
+ *
+ *  @param[out] boxes   Result boxes (count entries)
+ *  @param[in]  points  Points
+ *  @param[in]  offsets Point set offsets (count+1 entries)
+ *  @param[in]  count   Number of point sets
+ */
+void aabbFromPointsBatch(aabb *boxes, const vec3f *points, const size_t *offsets, size_t count);
+
+/*! Transform a bounding box by an affine matrix
+ *
+ *  Uses Arvo's method; the result bounds the transformed box.
+ *
+ *  @param[out] out Result box
+ *  @param[in]  in  Box to transform
+ *  @param[in]  m   Affine transform
+ */
+void aabbTransform(aabb *out, const aabb *in, const mtx44 *m);
+
+/*! Transform several bounding boxes by affine matrices
+ *
+ *  @param[out] out   Result boxes
+ *  @param[in]  in    Boxes to transform
+ *  @param[in]  m     Affine transforms (one per box)
+ *  @param[in]  count Number of boxes
+ */
+void aabbTransformBatch(aabb *out, const aabb *in, const mtx44 *m, size_t count);
+
+/*! Compute a bounding sphere of a set of points (Ritter's method)
+ *
+ *  An empty set produces a negative radius.
+ *
+ *  @param[out] s      Result sphere
+ *  @param[in]  points Points
+ *  @param[in]  count  Number of points
+ */
+void sphereFromPoints(sphere *s, const vec3f *points, size_t count);
+
+/*! Compute bounding spheres of several point sets
+ *
+ *  @param[out] spheres Result spheres (count entries)
+ *  @param[in]  points  Points
+ *  @param[in]  offsets Point set offsets (count+1 entries)
+ *  @param[in]  count   Number of point sets
+ */
+void sphereFromPointsBatch(sphere *spheres, const vec3f *points, const size_t *offsets, size_t count);
+
+/*! Compute an oriented bounding box of a set of points
+ *
+ *  The axes are the principal components of the point covariance. An empty
+ *  set produces negative extents.
+ *
+ *  @param[out] box    Result box
+ *  @param[in]  points Points
+ *  @param[in]  count  Number of points
+ */
+void obbFromPoints(obb *box, const vec3f *points, size_t count);
+
+/*! Compute oriented bounding boxes of several point sets
+ *
+ *  @param[out] boxes   Result boxes (count entries)
+ *  @param[in]  points  Points
+ *  @param[in]  offsets Point set offsets (count+1 entries)
+ *  @param[in]  count   Number of point sets
+ */
+void obbFromPointsBatch(obb *boxes, const vec3f *points, const size_t *offsets, size_t count);
+
+/*! Compute contacts between pairs of spheres
+ *
+ *  Pair n is a[n] and b[n]. Spheres with coincident centers get a +Y
+ *  normal.
+ *
+ *  @param[out] out   Contacts
+ *  @param[in]  a     First spheres
+ *  @param[in]  b     Second spheres
+ *  @param[in]  count Number of pairs
+ *
+ *  @returns number of pairs touching (depth >= 0)
+ */
+size_t sphereSphereContactBatch(contactSoA out, sphereSoA a, sphereSoA b, size_t count);
+
+/*! Compute contacts between pairs of spheres and boxes
+ *
+ *  A sphere whose center is inside its box is pushed out through the
+ *  nearest face.
+ *
+ *  @param[out] out   Contacts
+ *  @param[in]  a     Spheres
+ *  @param[in]  b     Boxes
+ *  @param[in]  count Number of pairs
+ *
+ *  @returns number of pairs touching (depth >= 0)
+ */
+size_t sphereAabbContactBatch(contactSoA out, sphereSoA a, aabbSoA b, size_t count);
+
+/*! Compute contacts between pairs of capsules
+ *
+ *  The contact is that of the spheres at the closest points of the two
+ *  axes.
+ *
+ *  @param[out] out   Contacts
+ *  @param[in]  a     First capsules
+ *  @param[in]  b     Second capsules
+ *  @param[in]  count Number of pairs
+ *
+ *  @returns number of pairs touching (depth >= 0)
+ */
+size_t capsuleCapsuleContactBatch(contactSoA out, capsuleSoA a, capsuleSoA b, size_t count);
+
+/*! Compute contacts between pairs of boxes
+ *
+ *  The normal is the axis of least overlap, the depth that overlap and the
+ *  point the center of the overlap region. Any negative overlap means the
+ *  boxes are apart; the depth is then negative but is not the distance.
+ *
+ *  @param[out] out   Contacts
+ *  @param[in]  a     First boxes
+ *  @param[in]  b     Second boxes
+ *  @param[in]  count Number of pairs
+ *
+ *  @returns number of pairs touching (depth >= 0)
+ */
+size_t aabbAabbContactBatch(contactSoA out, aabbSoA a, aabbSoA b, size_t count);
+
+/*! Intersect a ray with a triangle (Moller-Trumbore)
+ *
+ *  Distances are in units of the ray direction; only hits at t >= 0 count.
+ *
+ *  @param[in]  r  Ray
+ *  @param[in]  v0 First vertex
+ *  @param[in]  v1 Second vertex
+ *  @param[in]  v2 Third vertex
+ *  @param[out] t  Hit distance (may be NULL)
+ *  @param[out] u  Barycentric coordinate of v1 (may be NULL)
+ *  @param[out] v  Barycentric coordinate of v2 (may be NULL)
+ *
+ *  @returns whether the ray hits the triangle
+ */
+int rayTriangle(const ray *r, vec3f v0, vec3f v1, vec3f v2, float *t, float *u, float *v);
+
+/*! Intersect a ray with many triangles
+ *
+ *  @param[out] t        Hit distance per triangle (INFINITY on a miss)
+ *  @param[in]  r        Ray
+ *  @param[in]  vertices Triangle vertices (3 per triangle)
+ *  @param[in]  count    Number of triangles
+ */
+void rayTriangleBatch(float *t, const ray *r, const vec3f *vertices, size_t count);
+
+/*! Intersect a ray with a bounding box (slab test)
+ *
+ *  @param[in]  r    Ray
+ *  @param[in]  box  Box
+ *  @param[out] near Entry distance, clamped to 0 (may be NULL)
+ *  @param[out] far  Exit distance (may be NULL)
+ *
+ *  @returns whether the ray hits the box
+ */
+int rayAabb(const ray *r, const aabb *box, float *near, float *far);
+
+/*! Intersect a ray with many bounding boxes
+ *
+ *  @param[out] t     Entry distance per box, clamped to 0 (INFINITY on a miss)
+ *  @param[in]  r     Ray
+ *  @param[in]  boxes Boxes
+ *  @param[in]  count Number of boxes
+ */
+void rayAabbBatch(float *t, const ray *r, const aabb *boxes, size_t count);
+
+/*! Intersect a packet of 4 rays with a triangle
+ *
+ *  Each lane of t holds the closest distance found so far (INFINITY for
+ *  none) and is only updated by a closer hit.
+ *
+ *  @param[in,out] t  Closest hit distance per ray
+ *  @param[in]     r  Ray packet
+ *  @param[in]     v0 First vertex
+ *  @param[in]     v1 Second vertex
+ *  @param[in]     v2 Third vertex
+ *
+ *  @returns mask of the lanes that were updated
+ */
+unsigned ray4Triangle(float t[4], const ray4 *r, vec3f v0, vec3f v1, vec3f v2);
+
+/*! Intersect a packet of 8 rays with a triangle
+ *
+ *  @see ray4Triangle
+ *
+ *  @param[in,out] t  Closest hit distance per ray
+ *  @param[in]     r  Ray packet
+ *  @param[in]     v0 First vertex
+ *  @param[in]     v1 Second vertex
+ *  @param[in]     v2 Third vertex
+ *
+ *  @returns mask of the lanes that were updated
+ */
+unsigned ray8Triangle(float t[8], const ray8 *r, vec3f v0, vec3f v1, vec3f v2);
+
+/*! Intersect a packet of 4 rays with a bounding box
+ *
+ *  A lane hits if it enters the box closer than its distance in t; t itself
+ *  is not modified.
+ *
+ *  @param[in] t   Closest hit distance per ray
+ *  @param[in] r   Ray packet
+ *  @param[in] box Box
+ *
+ *  @returns mask of the lanes that hit
+ */
+unsigned ray4Aabb(const float t[4], const ray4 *r, const aabb *box);
+
+/*! Intersect a packet of 8 rays with a bounding box
+ *
+ *  @see ray4Aabb
+ *
+ *  @param[in] t   Closest hit distance per ray
+ *  @param[in] r   Ray packet
+ *  @param[in] box Box
+ *
+ *  @returns mask of the lanes that hit
+ */
+unsigned ray8Aabb(const float t[8], const ray8 *r, const aabb *box);
+
+/*! Build a BVH over primitive bounds using the surface area heuristic
+ *
+ *  @param[out] b     BVH
+ *  @param[in]  boxes Primitive bounds
+ *  @param[in]  count Number of primitives
+ *
+ *  @returns whether the BVH was built
+ */
+int bvhBuild(bvh *b, const aabb *boxes, size_t count);
+
+/*! Build a BVH over triangles
+ *
+ *  @param[out] b        BVH
+ *  @param[in]  vertices Triangle vertices (3 per triangle)
+ *  @param[in]  count    Number of triangles
+ *
+ *  @returns whether the BVH was built
+ */
+int bvhBuildTriangles(bvh *b, const vec3f *vertices, size_t count);
+
+/*! Free a BVH's storage
+ *
+ *  @param[in,out] b BVH
+ */
+void bvhFree(bvh *b);
+
+/*! Update a BVH's bounds after its primitives moved
+ *
+ *  The topology is kept, so quality degrades if primitives move far.
+ *
+ *  @param[in,out] b     BVH
+ *  @param[in]     boxes Primitive bounds
+ */
+void bvhRefit(bvh *b, const aabb *boxes);
+
+/*! Update a triangle BVH's bounds after its vertices moved
+ *
+ *  @param[in,out] b        BVH
+ *  @param[in]     vertices Triangle vertices (3 per triangle)
+ */
+void bvhRefitTriangles(bvh *b, const vec3f *vertices);
+
+/*! Find the closest triangle hit by a ray
+ *
+ *  @param[in]     b        Triangle BVH
+ *  @param[in]     r        Ray
+ *  @param[in]     vertices Triangle vertices (3 per triangle)
+ *  @param[in,out] t        Maximum distance; receives the hit distance
+ *  @param[out]    prim     Triangle hit (may be NULL)
+ *
+ *  @returns whether a triangle closer than t was hit
+ */
+int bvhClosestHit(const bvh *b, const ray *r, const vec3f *vertices, float *t, s32 *prim);
+
+/*! Check whether a ray hits any triangle
+ *
+ *  @param[in] b        Triangle BVH
+ *  @param[in] r        Ray
+ *  @param[in] vertices Triangle vertices (3 per triangle)
+ *  @param[in] tmax     Maximum distance
+ *
+ *  @returns whether a triangle closer than tmax was hit
+ */
+int bvhAnyHit(const bvh *b, const ray *r, const vec3f *vertices, float tmax);
+
+/*! Find the primitives whose bounds overlap a box
+ *
+ *  Without primitive bounds, every primitive in an overlapping leaf is
+ *  reported.
+ *
+ *  @param[in]  b     BVH
+ *  @param[in]  boxes Primitive bounds (may be NULL)
+ *  @param[in]  box   Query box
+ *  @param[out] prims Overlapping primitives (may be NULL if max is 0)
+ *  @param[in]  max   Capacity of prims
+ *
+ *  @returns number of overlapping primitives, which may exceed max
+ */
+size_t bvhOverlap(const bvh *b, const aabb *boxes, const aabb *box, s32 *prims, size_t max);
+
+/*! Initialize an empty spatial hash grid
+ *
+ *  @param[out] g        Grid
+ *  @param[in]  cellSize Cell edge length
+ */
+void hashGridInit(hashGrid *g, float cellSize);
+
+/*! Free a spatial hash grid's storage
+ *
+ *  @param[in,out] g Grid
+ */
+void hashGridFree(hashGrid *g);
+
+/*! Rebuild a spatial hash grid from object positions
+ *
+ *  Equivalent to hashGridReserve, hashGridAssign over all objects, then
+ *  hashGridCommit.
+ *
+ *  @param[in,out] g         Grid
+ *  @param[in]     positions Object positions
+ *  @param[in]     count     Number of objects
+ *
+ *  @returns whether the grid was rebuilt
+ */
+int hashGridRebuild(hashGrid *g, const vec3f *positions, size_t count);
+
+/*! Rebuild a spatial hash grid, assigning cells on a thread pool
+ *
+ *  @param[in]     pool      Thread pool (may be NULL)
+ *  @param[in,out] g         Grid
+ *  @param[in]     positions Object positions
+ *  @param[in]     count     Number of objects
+ *
+ *  @returns whether the grid was rebuilt
+ */
+int hashGridRebuildParallel(threadPool *pool, hashGrid *g, const vec3f *positions, size_t count);
+
+/*! Size a spatial hash grid for a rebuild
+ *
+ *  Storage only grows, so steady-state rebuilds do not allocate.
+ *
+ *  @param[in,out] g     Grid
+ *  @param[in]     count Number of objects
+ *
+ *  @returns whether the storage is available
+ */
+int hashGridReserve(hashGrid *g, size_t count);
+
+/*! Compute the cells of a range of objects
+ *
+ *  Calls on disjoint ranges may run concurrently.
+ *
+ *  @param[in,out] g         Grid
+ *  @param[in]     positions Object positions (all objects)
+ *  @param[in]     first     First object
+ *  @param[in]     count     Number of objects
+ */
+void hashGridAssign(hashGrid *g, const vec3f *positions, size_t first, size_t count);
+
+/*! Bucket the assigned objects by cell (counting sort)
+ *
+ *  @param[in,out] g Grid
+ */
+void hashGridCommit(hashGrid *g);
+
+/*! Look up the objects in a cell
+ *
+ *  @param[in]  g       Grid
+ *  @param[in]  cell    Cell
+ *  @param[out] entries Object indices in the cell
+ *
+ *  @returns number of objects in the cell
+ */
+size_t hashGridCell(const hashGrid *g, vec3i cell, const s32 **entries);
+
+/*! Find the objects in the 27 cells around a position
+ *
+ *  @param[in]  g        Grid
+ *  @param[in]  position Query position
+ *  @param[out] out      Object indices (may be NULL if max is 0)
+ *  @param[in]  max      Capacity of out
+ *
+ *  @returns number of objects found, which may exceed max
+ */
+size_t hashGridQuery(const hashGrid *g, vec3f position, s32 *out, size_t max);
+
+/*! Create a thread pool
+ *
+ *  The thread calling threadPoolFor is one of the workers, so threads-1
+ *  threads are started. On the 3DS no threads are started and this returns
+ *  NULL, which every function taking a pool accepts.
+ *
+ *  @param[in] threads Number of workers (0 for one per CPU)
+ *
+ *  @returns thread pool, or NULL
+ */
+threadPool* threadPoolCreate(unsigned threads);
+
+/*! Stop a thread pool's threads and free it
+ *
+ *  @param[in] pool Thread pool (may be NULL)
+ */
+void threadPoolDestroy(threadPool *pool);
+
+/*! Get the number of workers in a thread pool
+ *
+ *  @param[in] pool Thread pool (may be NULL)
+ *
+ *  @returns number of workers, including the calling thread
+ */
+unsigned threadPoolSize(const threadPool *pool);
+
+/*! Run a function over an index range on a thread pool
+ *
+ *  The range is cut into chunks, about eight per worker, sized to whole
+ *  64-byte lines of an output with elements of the given size. Workers that
+ *  run out steal half of another's remaining chunks. Returns once every
+ *  chunk is done. A NULL pool runs fn(arg, 0, count) on the calling thread.
+ *  A pool runs one threadPoolFor at a time.
+ *
+ *  @param[in] pool  Thread pool (may be NULL)
+ *  @param[in] count Number of indices
+ *  @param[in] size  Size of an output element in bytes
+ *  @param[in] fn    Range callback
+ *  @param[in] arg   User argument
+ */
+void threadPoolFor(threadPool *pool, size_t count, size_t size, threadPoolFunc fn, void *arg);
+
+/*! Multiply arrays of mtx44's on a thread pool
+ *
+ *  @param[in]  pool  Thread pool (may be NULL)
+ *  @param[out] m     Result matrices
+ *  @param[in]  lhs   Left sides
+ *  @param[in]  rhs   Right sides
+ *  @param[in]  count Number of matrices
+ */
+void mtx44MultiplyBatchParallel(threadPool *pool, mtx44 *m, const mtx44 *lhs, const mtx44 *rhs, size_t count);
+
+/*! Transform an array of points by an affine matrix on a thread pool
+ *
+ *  @param[in]  pool  Thread pool (may be NULL)
+ *  @param[out] out   Transformed points (may alias in)
+ *  @param[in]  m     Affine transform
+ *  @param[in]  in    Points
+ *  @param[in]  count Number of points
+ */
+void mtx44TransformBatchParallel(threadPool *pool, vec3f *out, const mtx44 *m, const vec3f *in, size_t count);
+
+/*! Multiply arrays of quaternions on a thread pool
+ *
+ *  @param[in]  pool  Thread pool (may be NULL)
+ *  @param[out] out   Results (may alias lhs or rhs)
+ *  @param[in]  lhs   Left sides
+ *  @param[in]  rhs   Right sides
+ *  @param[in]  count Number of quaternions
+ */
+void quatMultiplyBatchParallel(threadPool *pool, quat *out, const quat *lhs, const quat *rhs, size_t count);
+
+/*! Convert an array of quaternions into 4x4 matrices on a thread pool
+ *
+ *  @param[in]  pool  Thread pool (may be NULL)
+ *  @param[out] m     Result matrices
+ *  @param[in]  q     Quaternions
+ *  @param[in]  count Number of quaternions
+ */
+void quatToMtx44BatchParallel(threadPool *pool, mtx44 *m, const quat *q, size_t count);
+
+/*! Set up a skeleton
+ *
+ *  @param[out] s           Skeleton
+ *  @param[in]  parents     Parent of each bone (-1 for a root)
+ *  @param[in]  inverseBind Inverse bind matrix of each bone (affine)
+ *  @param[in]  count       Number of bones
+ *
+ *  @returns whether the arrays were given, the storage was allocated and
+ *           every parent precedes its child
+ */
+int skeletonInit(skeleton *s, const s32 *parents, const mtx44 *inverseBind, size_t count);
+
+/*! Free a skeleton's storage
+ *
+ *  @param[in,out] s Skeleton
+ */
+void skeletonFree(skeleton *s);
+
+/*! Build world and skinning matrices from a pose
+ *
+ *  Each bone goes from its local transform to its world matrix
+ *  (parent world * local) and palette matrix (world * inverse bind) in one
+ *  pass, with affine products throughout.
+ *
+ *  @param[in]  s       Skeleton
+ *  @param[in]  pose    Local transform of each bone
+ *  @param[out] world   World matrix of each bone
+ *  @param[out] palette Skinning matrix of each bone
+ */
+void skeletonPalette(const skeleton *s, const boneTransform *pose, mtx44 *world, mtx44 *palette);
+
+/*! Build world and affine skinning matrices from a pose
+ *
+ *  Like skeletonPalette, but each skinning matrix is written as its top
+ *  three rows, the form a vertex shader needs: 3 vec4f's per bone.
+ *
+ *  @param[in]  s       Skeleton
+ *  @param[in]  pose    Local transform of each bone
+ *  @param[out] world   World matrix of each bone
+ *  @param[out] palette Skinning matrix rows
+ */
+void skeletonPaletteAffine(const skeleton *s, const boneTransform *pose, mtx44 *world, vec4f *palette);
+
+/*! Build world and skinning matrices for many poses of one skeleton
+ *
+ *  Pose n and its outputs start at index n * s->count.
+ *
+ *  @param[in]  s         Skeleton
+ *  @param[in]  pose      Local transforms
+ *  @param[out] world     World matrices
+ *  @param[out] palette   Skinning matrices
+ *  @param[in]  instances Number of poses
+ */
+void skeletonPaletteBatch(const skeleton *s, const boneTransform *pose, mtx44 *world, mtx44 *palette, size_t instances);
+
+/*! Build world and skinning matrices for many poses on a thread pool
+ *
+ *  @param[in]  pool      Thread pool (may be NULL)
+ *  @param[in]  s         Skeleton
+ *  @param[in]  pose      Local transforms
+ *  @param[out] world     World matrices
+ *  @param[out] palette   Skinning matrices
+ *  @param[in]  instances Number of poses
+ */
+void skeletonPaletteBatchParallel(threadPool *pool, const skeleton *s, const boneTransform *pose, mtx44 *world, mtx44 *palette, size_t instances);
+
+/*! Build Catmull-Rom segments through a sequence of points
+ *
+ *  Segment n runs from points[n+1] to points[n+2], so the first and last
+ *  points only shape the ends of the path.
+ *
+ *  @param[out] out    count-3 segments
+ *  @param[in]  points Control points
+ *  @param[in]  count  Number of control points (at least 4)
+ */
+void cubicFromCatmullRomBatch(cubic *out, const vec3f *points, size_t count);
+
+/*! Evaluate one cubic at many parameters
+ *
+ *  @param[out] out   Points
+ *  @param[in]  c     Curve
+ *  @param[in]  t     Parameters
+ *  @param[in]  count Number of parameters
+ */
+void cubicEvaluateBatch(vec3f *out, const cubic *c, const float *t, size_t count);
+
+/*! Evaluate many cubics, each at its own parameter
+ *
+ *  @param[out] out    Points
+ *  @param[in]  curves Curves
+ *  @param[in]  t      Parameter per curve
+ *  @param[in]  count  Number of curves
+ */
+void cubicEvaluateCurvesBatch(vec3f *out, const cubic *curves, const float *t, size_t count);
+
+/*! Tessellate many cubics at uniform steps using forward differencing
+ *
+ *  Curve n is written to out[n*(steps+1)] through out[n*(steps+1)+steps],
+ *  at t = 0, 1/steps, ..., 1. The point at t = 1 is computed directly
+ *  rather than stepped, so it carries no forward-differencing error, but
+ *  it is only equal to the next segment's start to within rounding; reuse
+ *  that point if the joins must be exact.
+ *
+ *  @param[out] out    count*(steps+1) points
+ *  @param[in]  curves Curves
+ *  @param[in]  count  Number of curves
+ *  @param[in]  steps  Steps per curve (at least 1)
+ */
+void cubicTessellateBatch(vec3f *out, const cubic *curves, size_t count, size_t steps);
+
+/*! Element size of a mathFile section type
+ *
+ *  @param[in] type Element type
+ *
+ *  @returns element size in bytes, or 0 if type is unknown
+ */
+size_t mathFileElementSize(u32 type);
+
+/*! FNV-1a checksum as stored in mathFile section entries
+ *
+ *  @param[in] data Bytes
+ *  @param[in] size Number of bytes
+ *
+ *  @returns checksum
+ */
+u32 mathFileChecksum(const void *data, size_t size);
+
+/*! Write sections to a mathFile
+ *
+ *  Section data is written as-is, so the host must be little-endian (as
+ *  are the 3DS and x86). Each section starts on a MATH_FILE_ALIGN boundary.
+ *
+ *  @param[in] path     Output path
+ *  @param[in] sections Sections to write
+ *  @param[in] count    Number of sections
+ *
+ *  @returns whether the file was written
+ */
+int mathFileWrite(const char *path, const mathFileSource *sections, size_t count);
+
+/*! Validate a mathFile image in memory
+ *
+ *  The header and section table are checked (magic, version, endianness,
+ *  bounds, alignment and element types); section data is not read, so
+ *  this is cheap regardless of file size. The image must outlive f and be
+ *  16-byte aligned; if it is MATH_FILE_ALIGN-aligned, so is every section.
+ *
+ *  @param[out] f    File
+ *  @param[in]  data Image
+ *  @param[in]  size Image size in bytes
+ *
+ *  @returns whether the image is a valid mathFile
+ */
+int mathFileLoad(mathFile *f, const void *data, size_t size);
+
+/*! Map and validate a mathFile
+ *
+ *  Sections are used in place, so only the pages actually touched are
+ *  read. Where mmap is unavailable (ARM11), the file is read into an
+ *  aligned heap copy instead.
+ *
+ *  @param[out] f    File
+ *  @param[in]  path Path
+ *
+ *  @returns whether the file was opened and is valid
+ */
+int mathFileOpen(mathFile *f, const char *path);
+
+/*! Release a mathFile opened with mathFileOpen or mathFileLoad
+ *
+ *  @param[in] f File
+ */
+void mathFileClose(mathFile *f);
+
+/*! Find a section
+ *
+ *  @param[in]  f     File
+ *  @param[in]  type  Element type
+ *  @param[in]  id    User identifier
+ *  @param[out] count Number of elements (may be NULL)
+ *
+ *  @returns section data, or NULL if there is no such section
+ */
+const void* mathFileFind(const mathFile *f, u32 type, u32 id, size_t *count);
+
+/*! Check section checksums
+ *
+ *  This reads every section, so it is meant for tools and debug builds
+ *  rather than load paths.
+ *
+ *  @param[in] f File
+ *
+ *  @returns whether all sections match their checksums
+ */
+int mathFileVerify(const mathFile *f);
+
+#ifdef GS_MATH_PROFILE
+#include <stdio.h>
+
+/*! Read the instrumentation counters
+ *
+ *  Built with GS_MATH_PROFILE (make PROFILE=1), every exported function
+ *  counts its calls and inclusive ticks in per-thread counters: TSC ticks
+ *  on x86, system ticks (CPU cycles) on the 3DS, nanoseconds elsewhere.
+ *  Snapshots sum all threads, including ones that have exited. Without
+ *  GS_MATH_PROFILE this and the other profile functions do nothing.
+ *
+ *  @param[out] out Counters per instrumented function called so far
+ *  @param[in]  max Capacity of out
+ *
+ *  @returns number of functions, which may exceed max
+ */
+size_t profileSnapshot(profileEntry *out, size_t max);
+
+/*! Restart all instrumentation counters from zero */
+void profileReset(void);
+
+/*! Print the instrumentation counters, busiest first
+ *
+ *  @param[in] fp Output stream
+ */
+void profileDump(FILE *fp);
+#else
+static inline size_t
+profileSnapshot(profileEntry *out, size_t max)
+{
+  (void)out;
+  (void)max;
+  return 0;
+}
+
+static inline void
+profileReset(void)
+{
+}
+
+/* a macro, so that FILE (and stdio.h) is only needed when profiling */
+#define profileDump(fp) ((void)(fp))
+#endif
+
+/*! Find a mtx44 section
+ *
+ *  @param[in]  f     File
+ *  @param[in]  id    User identifier
+ *  @param[out] count Number of matrices (may be NULL)
+ *
+ *  @returns matrices, or NULL if there is no such section
+ */
+static inline const mtx44*
+mathFileMtx44(const mathFile *f, u32 id, size_t *count)
+{
+  return (const mtx44*)mathFileFind(f, MATH_FILE_MTX44, id, count);
+}
+
+/*! Find a quat section
+ *
+ *  @param[in]  f     File
+ *  @param[in]  id    User identifier
+ *  @param[out] count Number of quaternions (may be NULL)
+ *
+ *  @returns quaternions, or NULL if there is no such section
+ */
+static inline const quat*
+mathFileQuat(const mathFile *f, u32 id, size_t *count)
+{
+  return (const quat*)mathFileFind(f, MATH_FILE_QUAT, id, count);
+}
+
+/*! Find a vec3f section
+ *
+ *  @param[in]  f     File
+ *  @param[in]  id    User identifier
+ *  @param[out] count Number of vectors (may be NULL)
+ *
+ *  @returns vectors, or NULL if there is no such section
+ */
+static inline const vec3f*
+mathFileVec3f(const mathFile *f, u32 id, size_t *count)
+{
+  return (const vec3f*)mathFileFind(f, MATH_FILE_VEC3F, id, count);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,583 @@
+#pragma once
+
+#include "gs_math.h"
+
+/*! Compile-time counterparts of the gs_math.h builders
+ *
+ *  Everything here is C++11 constexpr, so fixed transforms (UI layouts,
+ *  fixed projections, 90-degree rotation tables) can be baked into
+ *  read-only data:
+ *
+ *    constexpr mtx44 ui = gs::mtx44Ortho(0.0f, 400.0f, 0.0f, 240.0f, 0.0f, 1.0f);
+ *
+ *  The matrix builders take and return values rather than mutating through
+ *  a pointer, but otherwise follow the C functions of the same name (same
+ *  conventions, same operation order). Trigonometry is evaluated in double
+ *  precision, so results may differ from the runtime versions by an ulp.
+ *  When called with non-constant arguments these are ordinary (slow)
+ *  functions; prefer the C API at runtime.
+ */
+namespace gs
+{
+namespace detail
+{
+constexpr double pi = 3.14159265358979323846;
+
+/* x reduced to [-pi, pi] */
+constexpr double reduce(double x)
+{
+  return x - 2.0*pi * static_cast<double>(static_cast<long long>(x / (2.0*pi) + (x < 0.0 ? -0.5 : 0.5)));
+}
+
+/* sum + term + ... for the Taylor series of sin (n = 1) or cos (n = 0) */
+constexpr double series(double x2, double term, double sum, int n)
+{
+  return sum + term == sum ? sum
+       : series(x2, -term * x2 / ((n+1) * (n+2)), sum + term, n + 2);
+}
+
+constexpr double sin(double x)
+{
+  return series(x*x, x, 0.0, 1);
+}
+
+constexpr double cos(double x)
+{
+  return series(x*x, 1.0, 0.0, 0);
+}
+
+/* Newton iteration from above until the estimate stops decreasing */
+constexpr double sqrt(double x, double guess)
+{
+  return 0.5 * (guess + x / guess) >= guess ? guess : sqrt(x, 0.5 * (guess + x / guess));
+}
+
+constexpr double sqrt(double x)
+{
+  return x <= 0.0 ? 0.0 : sqrt(x, x < 1.0 ? 1.0 : x);
+}
+
+/* column i of m */
+constexpr vec4f column(const mtx44 &m, int i)
+{
+  return vec4f{ m.v[i*4+0], m.v[i*4+1], m.v[i*4+2], m.v[i*4+3] };
+}
+
+/* a*x + b*y + c*z + d*w */
+constexpr vec4f combine(vec4f a, float x, vec4f b, float y, vec4f c, float z, vec4f d, float w)
+{
+  return vec4f{ a.x*x + b.x*y + c.x*z + d.x*w,
+                a.y*x + b.y*y + c.y*z + d.y*w,
+                a.z*x + b.z*y + c.z*z + d.z*w,
+                a.w*x + b.w*y + c.w*z + d.w*w };
+}
+
+constexpr vec4f scale(vec4f a, float s)
+{
+  return vec4f{ a.x*s, a.y*s, a.z*s, a.w*s };
+}
+
+constexpr mtx44 fromColumns(vec4f c0, vec4f c1, vec4f c2, vec4f c3)
+{
+  return mtx44{{ c0.x, c0.y, c0.z, c0.w,
+                 c1.x, c1.y, c1.z, c1.w,
+                 c2.x, c2.y, c2.z, c2.w,
+                 c3.x, c3.y, c3.z, c3.w }};
+}
+
+/* column i of lhs*rhs */
+constexpr vec4f multiplyColumn(const mtx44 &lhs, const mtx44 &rhs, int i)
+{
+  return combine(column(lhs, 0), rhs.v[i*4+0],
+                 column(lhs, 1), rhs.v[i*4+1],
+                 column(lhs, 2), rhs.v[i*4+2],
+                 column(lhs, 3), rhs.v[i*4+3]);
+}
+
+/* m * R, where R is the rotation whose upper 3x3 has columns r0, r1, r2 */
+constexpr mtx44 rotate(const mtx44 &m, vec3f r0, vec3f r1, vec3f r2)
+{
+  return fromColumns(combine(column(m, 0), r0.x, column(m, 1), r0.y, column(m, 2), r0.z, column(m, 3), 0.0f),
+                     combine(column(m, 0), r1.x, column(m, 1), r1.y, column(m, 2), r1.z, column(m, 3), 0.0f),
+                     combine(column(m, 0), r2.x, column(m, 1), r2.y, column(m, 2), r2.z, column(m, 3), 0.0f),
+                     column(m, 3));
+}
+
+/* rotation about a unit axis given sin, cos and 1 - cos */
+constexpr mtx44 rotate(const mtx44 &m, vec3f a, float s, float c, float t)
+{
+  return rotate(m, vec3f{ t*a.x*a.x + c,     t*a.x*a.y + s*a.z, t*a.x*a.z - s*a.y },
+                   vec3f{ t*a.y*a.x - s*a.z, t*a.y*a.y + c,     t*a.y*a.z + s*a.x },
+                   vec3f{ t*a.z*a.x + s*a.y, t*a.z*a.y - s*a.x, t*a.z*a.z + c     });
+}
+
+constexpr mtx44 lookAt(vec3f s, vec3f u, vec3f f, vec3f eye)
+{
+  return mtx44{{ s.x, u.x, -f.x, 0.0f,
+                 s.y, u.y, -f.y, 0.0f,
+                 s.z, u.z, -f.z, 0.0f,
+                 -(s.x*eye.x + s.y*eye.y + s.z*eye.z),
+                 -(u.x*eye.x + u.y*eye.y + u.z*eye.z),
+                 f.x*eye.x + f.y*eye.y + f.z*eye.z,
+                 1.0f }};
+}
+
+constexpr vec3f cross(vec3f a, vec3f b)
+{
+  return vec3f{ a.y*b.z - a.z*b.y, a.z*b.x - a.x*b.z, a.x*b.y - a.y*b.x };
+}
+
+constexpr vec3f normalize(vec3f v, double len)
+{
+  return vec3f{ static_cast<float>(v.x / len), static_cast<float>(v.y / len), static_cast<float>(v.z / len) };
+}
+
+constexpr vec3f normalize(vec3f v)
+{
+  return normalize(v, sqrt(v.x*v.x + v.y*v.y + v.z*v.z));
+}
+
+/* view matrix from unit forward and side vectors */
+constexpr mtx44 lookAtSide(vec3f f, vec3f s, vec3f eye)
+{
+  return lookAt(s, cross(s, f), f, eye);
+}
+
+/* view matrix from unit forward and up vectors */
+constexpr mtx44 lookAtForward(vec3f f, vec3f up, vec3f eye)
+{
+  return lookAtSide(f, normalize(cross(f, up)), eye);
+}
+
+constexpr mtx44 perspective(float f, float aspect, float near, float far)
+{
+  return mtx44{{ f * aspect, 0.0f, 0.0f,                              0.0f,
+                 0.0f,       f,    0.0f,                              0.0f,
+                 0.0f,       0.0f, (far + near) / (near - far),       -1.0f,
+                 0.0f,       0.0f, 2.0f * far * near / (near - far),  0.0f }};
+}
+
+/* q rotated about a unit axis given cos and sin of the half angle */
+constexpr quat rotate(quat q, vec3f a, float c, float s)
+{
+  return quat{ q.r*c - q.i*a.x*s - q.j*a.y*s - q.k*a.z*s,
+               q.r*a.x*s + q.i*c + q.j*a.z*s - q.k*a.y*s,
+               q.r*a.y*s + q.j*c + q.k*a.x*s - q.i*a.z*s,
+               q.r*a.z*s + q.k*c + q.i*a.y*s - q.j*a.x*s };
+}
+
+constexpr quat scale(quat q, double s)
+{
+  return quat{ static_cast<float>(q.r * s), static_cast<float>(q.i * s),
+               static_cast<float>(q.j * s), static_cast<float>(q.k * s) };
+}
+
+constexpr quat rotateX(quat q, float c, float s)
+{
+  return quat{ q.r*c - q.i*s, q.r*s + q.i*c, q.j*c + q.k*s, q.k*c - q.j*s };
+}
+
+constexpr quat rotateY(quat q, float c, float s)
+{
+  return quat{ q.r*c - q.j*s, q.i*c - q.k*s, q.r*s + q.j*c, q.k*c + q.i*s };
+}
+
+constexpr quat rotateZ(quat q, float c, float s)
+{
+  return quat{ q.r*c - q.k*s, q.i*c + q.j*s, q.j*c - q.i*s, q.r*s + q.k*c };
+}
+} // namespace detail
+
+/*! Compile-time sine
+ *
+ *  @param[in] radians Angle
+ *
+ *  @returns sin(radians)
+ */
+constexpr float sin(float radians)
+{
+  return static_cast<float>(detail::sin(detail::reduce(radians)));
+}
+
+/*! Compile-time cosine
+ *
+ *  @param[in] radians Angle
+ *
+ *  @returns cos(radians)
+ */
+constexpr float cos(float radians)
+{
+  return static_cast<float>(detail::cos(detail::reduce(radians)));
+}
+
+/*! Compile-time tangent
+ *
+ *  @param[in] radians Angle
+ *
+ *  @returns tan(radians)
+ */
+constexpr float tan(float radians)
+{
+  return static_cast<float>(detail::sin(detail::reduce(radians))
+                          / detail::cos(detail::reduce(radians)));
+}
+
+/*! Compile-time square root
+ *
+ *  @param[in] x Non-negative value
+ *
+ *  @returns sqrt(x)
+ */
+constexpr float sqrt(float x)
+{
+  return static_cast<float>(detail::sqrt(x));
+}
+
+/*! Add two vec3f's
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs+rhs
+ */
+constexpr vec3f vec3fAdd(vec3f lhs, vec3f rhs)
+{
+  return vec3f{ lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z };
+}
+
+/*! Subtract two vec3f's
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs-rhs
+ */
+constexpr vec3f vec3fSubtract(vec3f lhs, vec3f rhs)
+{
+  return vec3f{ lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z };
+}
+
+/*! Scale a vec3f
+ *
+ *  @param[in] v Vector to scale
+ *  @param[in] s Scale factor
+ *
+ *  @returns v*s
+ */
+constexpr vec3f vec3fScale(vec3f v, float s)
+{
+  return vec3f{ v.x*s, v.y*s, v.z*s };
+}
+
+/*! Cross product of two vec3f's
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs x rhs
+ */
+constexpr vec3f vec3fCross(vec3f lhs, vec3f rhs)
+{
+  return vec3f{ lhs.y*rhs.z - lhs.z*rhs.y,
+                lhs.z*rhs.x - lhs.x*rhs.z,
+                lhs.x*rhs.y - lhs.y*rhs.x };
+}
+
+/*! Dot product of two vec3f's
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs . rhs
+ */
+constexpr float vec3fDot(vec3f lhs, vec3f rhs)
+{
+  return lhs.x*rhs.x + lhs.y*rhs.y + lhs.z*rhs.z;
+}
+
+/*! Normalize a vec3f
+ *
+ *  @param[in] v Vector to normalize
+ *
+ *  @returns normalized v
+ */
+constexpr vec3f vec3fNormalize(vec3f v)
+{
+  return detail::normalize(v);
+}
+
+/*! Identity mtx44
+ *
+ *  @returns identity matrix
+ */
+constexpr mtx44 mtx44Identity()
+{
+  return mtx44{{ 1.0f, 0.0f, 0.0f, 0.0f,
+                 0.0f, 1.0f, 0.0f, 0.0f,
+                 0.0f, 0.0f, 1.0f, 0.0f,
+                 0.0f, 0.0f, 0.0f, 1.0f }};
+}
+
+/*! Multiply two mtx44's
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs*rhs
+ */
+constexpr mtx44 mtx44Multiply(const mtx44 &lhs, const mtx44 &rhs)
+{
+  return detail::fromColumns(detail::multiplyColumn(lhs, rhs, 0),
+                             detail::multiplyColumn(lhs, rhs, 1),
+                             detail::multiplyColumn(lhs, rhs, 2),
+                             detail::multiplyColumn(lhs, rhs, 3));
+}
+
+/*! Translate a mtx44
+ *
+ *  @param[in] m Matrix to translate
+ *  @param[in] x X component to translate
+ *  @param[in] y Y component to translate
+ *  @param[in] z Z component to translate
+ *
+ *  @returns m*T(x,y,z)
+ */
+constexpr mtx44 mtx44Translate(const mtx44 &m, float x, float y, float z)
+{
+  return detail::fromColumns(detail::column(m, 0),
+                             detail::column(m, 1),
+                             detail::column(m, 2),
+                             detail::combine(detail::column(m, 0), x,
+                                             detail::column(m, 1), y,
+                                             detail::column(m, 2), z,
+                                             detail::column(m, 3), 1.0f));
+}
+
+/*! Scale a mtx44
+ *
+ *  @param[in] m Matrix to scale
+ *  @param[in] x X component to scale
+ *  @param[in] y Y component to scale
+ *  @param[in] z Z component to scale
+ *
+ *  @returns m*S(x,y,z)
+ */
+constexpr mtx44 mtx44Scale(const mtx44 &m, float x, float y, float z)
+{
+  return detail::fromColumns(detail::scale(detail::column(m, 0), x),
+                             detail::scale(detail::column(m, 1), y),
+                             detail::scale(detail::column(m, 2), z),
+                             detail::column(m, 3));
+}
+
+/*! Rotate a mtx44 about an arbitrary axis
+ *
+ *  @param[in] m    Matrix to rotate
+ *  @param[in] axis Axis to rotate about
+ *  @param[in] r    Radians to rotate
+ *
+ *  @returns m*R(axis,r)
+ */
+constexpr mtx44 mtx44Rotate(const mtx44 &m, vec3f axis, float r)
+{
+  return detail::rotate(m, detail::normalize(axis), gs::sin(r), gs::cos(r), 1.0f - gs::cos(r));
+}
+
+/*! Rotate a mtx44 about the X axis
+ *
+ *  @param[in] m Matrix to rotate
+ *  @param[in] r Radians to rotate
+ *
+ *  @returns m*Rx(r)
+ */
+constexpr mtx44 mtx44RotateX(const mtx44 &m, float r)
+{
+  return detail::rotate(m, vec3f{ 1.0f, 0.0f, 0.0f },
+                           vec3f{ 0.0f, gs::cos(r), gs::sin(r) },
+                           vec3f{ 0.0f, -gs::sin(r), gs::cos(r) });
+}
+
+/*! Rotate a mtx44 about the Y axis
+ *
+ *  @param[in] m Matrix to rotate
+ *  @param[in] r Radians to rotate
+ *
+ *  @returns m*Ry(r)
+ */
+constexpr mtx44 mtx44RotateY(const mtx44 &m, float r)
+{
+  return detail::rotate(m, vec3f{ gs::cos(r), 0.0f, -gs::sin(r) },
+                           vec3f{ 0.0f, 1.0f, 0.0f },
+                           vec3f{ gs::sin(r), 0.0f, gs::cos(r) });
+}
+
+/*! Rotate a mtx44 about the Z axis
+ *
+ *  @param[in] m Matrix to rotate
+ *  @param[in] r Radians to rotate
+ *
+ *  @returns m*Rz(r)
+ */
+constexpr mtx44 mtx44RotateZ(const mtx44 &m, float r)
+{
+  return detail::rotate(m, vec3f{ gs::cos(r), gs::sin(r), 0.0f },
+                           vec3f{ -gs::sin(r), gs::cos(r), 0.0f },
+                           vec3f{ 0.0f, 0.0f, 1.0f });
+}
+
+/*! Perspective projection
+ *
+ *  @param[in] fovy   Vertical field of view in radians
+ *  @param[in] aspect Aspect ratio (height/width)
+ *  @param[in] near   Near clip plane (> 0)
+ *  @param[in] far    Far clip plane (> near)
+ *
+ *  @returns projection matrix
+ */
+constexpr mtx44 mtx44Perpective(float fovy, float aspect, float near, float far)
+{
+  return detail::perspective(1.0f / gs::tan(fovy / 2.0f), aspect, near, far);
+}
+
+/*! Orthographic projection
+ *
+ *  @param[in] left   Left clip plane
+ *  @param[in] right  Right clip plane
+ *  @param[in] bottom Bottom clip plane
+ *  @param[in] top    Top clip plane
+ *  @param[in] near   Near clip plane
+ *  @param[in] far    Far clip plane
+ *
+ *  @returns projection matrix
+ */
+constexpr mtx44 mtx44Ortho(float left, float right, float bottom, float top, float near, float far)
+{
+  return mtx44{{ 2.0f / (right - left), 0.0f, 0.0f, 0.0f,
+                 0.0f, 2.0f / (top - bottom), 0.0f, 0.0f,
+                 0.0f, 0.0f, -2.0f / (far - near), 0.0f,
+                 -(right + left) / (right - left),
+                 -(top + bottom) / (top - bottom),
+                 -(far + near) / (far - near),
+                 1.0f }};
+}
+
+/*! Look-at view matrix
+ *
+ *  @param[in] eye    Camera position
+ *  @param[in] target Point to look at
+ *  @param[in] up     Up direction
+ *
+ *  @returns view matrix
+ */
+constexpr mtx44 mtx44LookAt(vec3f eye, vec3f target, vec3f up)
+{
+  return detail::lookAtForward(detail::normalize(gs::vec3fSubtract(target, eye)), up, eye);
+}
+
+/*! Identity quaternion
+ *
+ *  @returns identity quaternion
+ */
+constexpr quat quatIdentity()
+{
+  return quat{ 1.0f, 0.0f, 0.0f, 0.0f };
+}
+
+/*! Multiply two quaternions (concatenation)
+ *
+ *  @param[in] lhs Left side
+ *  @param[in] rhs Right side
+ *
+ *  @returns lhs*rhs
+ */
+constexpr quat quatMultiply(quat lhs, quat rhs)
+{
+  return quat{ lhs.r*rhs.r - lhs.i*rhs.i - lhs.j*rhs.j - lhs.k*rhs.k,
+               lhs.r*rhs.i + lhs.i*rhs.r + lhs.j*rhs.k - lhs.k*rhs.j,
+               lhs.r*rhs.j + lhs.j*rhs.r + lhs.k*rhs.i - lhs.i*rhs.k,
+               lhs.r*rhs.k + lhs.k*rhs.r + lhs.i*rhs.j - lhs.j*rhs.i };
+}
+
+/*! Normalize a quaternion
+ *
+ *  @param[in] q Quaternion
+ *
+ *  @returns normalized q
+ */
+constexpr quat quatNormalize(quat q)
+{
+  return detail::scale(q, 1.0 / detail::sqrt(q.r*q.r + q.i*q.i + q.j*q.j + q.k*q.k));
+}
+
+/*! Rotate a quaternion about an an axis
+ *
+ *  @param[in] q       Quaternion
+ *  @param[in] axis    Axis to rotate about
+ *  @param[in] radians Angle to rotate
+ *
+ *  @returns transformed quaternion
+ */
+constexpr quat quatRotate(quat q, vec3f axis, float radians)
+{
+  return detail::rotate(q, detail::normalize(axis), gs::cos(radians/2), gs::sin(radians/2));
+}
+
+/*! Rotate a quaternion about the X-axis
+ *
+ *  @param[in] q       Quaternion
+ *  @param[in] radians Angle to rotate
+ *
+ *  @returns transformed quaternion
+ */
+constexpr quat quatRotateX(quat q, float radians)
+{
+  return detail::rotateX(q, gs::cos(radians/2), gs::sin(radians/2));
+}
+
+/*! Rotate a quaternion about the Y-axis
+ *
+ *  @param[in] q       Quaternion
+ *  @param[in] radians Angle to rotate
+ *
+ *  @returns transformed quaternion
+ */
+constexpr quat quatRotateY(quat q, float radians)
+{
+  return detail::rotateY(q, gs::cos(radians/2), gs::sin(radians/2));
+}
+
+/*! Rotate a quaternion about the Z-axis
+ *
+ *  @param[in] q       Quaternion
+ *  @param[in] radians Angle to rotate
+ *
+ *  @returns transformed quaternion
+ */
+constexpr quat quatRotateZ(quat q, float radians)
+{
+  return detail::rotateZ(q, gs::cos(radians/2), gs::sin(radians/2));
+}
+
+/*! Convert a quaternion to a rotation mtx44
+ *
+ *  @param[in] q Quaternion (unit length)
+ *
+ *  @returns rotation matrix
+ */
+constexpr mtx44 quatToMtx44(quat q)
+{
+  return mtx44{{ 1.0f - 2.0f * (q.j*q.j + q.k*q.k),
+                 2.0f * (q.i*q.j + q.r*q.k),
+                 2.0f * (q.i*q.k - q.r*q.j),
+                 0.0f,
+                 2.0f * (q.i*q.j - q.r*q.k),
+                 1.0f - 2.0f * (q.i*q.i + q.k*q.k),
+                 2.0f * (q.j*q.k + q.r*q.i),
+                 0.0f,
+                 2.0f * (q.i*q.k + q.r*q.j),
+                 2.0f * (q.j*q.k - q.r*q.i),
+                 1.0f - 2.0f * (q.i*q.i + q.j*q.j),
+                 0.0f,
+                 0.0f, 0.0f, 0.0f, 1.0f }};
+}
+} // namespace gs
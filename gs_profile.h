@@ -0,0 +1,73 @@
+#pragma once
+
+/* Per-function instrumentation for the library's own translation units.
+ *
+ * Exported functions start with PROFILE_FUNCTION(). Unless GS_MATH_PROFILE
+ * is defined this expands to nothing; otherwise it counts the call and its
+ * inclusive duration in the calling thread's counters (see profileSnapshot).
+ */
+
+#ifdef GS_MATH_PROFILE
+
+#include "gs_math.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(ARM11)
+#include <time.h>
+#endif
+
+/* per-function registration; index is assigned on first call */
+typedef struct
+{
+  const char *name;
+  u32         index;
+} profileSite;
+
+typedef struct
+{
+  u32 index;
+  u64 start;
+} profileScope;
+
+u32  profileRegister(profileSite *site);
+void profileRecord(u32 index, u64 ticks);
+
+static inline u64
+profileTicks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(ARM11)
+  return svcGetSystemTick();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec * 1000000000u + ts.tv_nsec;
+#endif
+}
+
+static inline u32
+profileSiteIndex(profileSite *site)
+{
+  u32 index = __atomic_load_n(&site->index, __ATOMIC_ACQUIRE);
+
+  return index ? index : profileRegister(site);
+}
+
+static inline void
+profileScopeEnd(profileScope *scope)
+{
+  profileRecord(scope->index, profileTicks() - scope->start);
+}
+
+#define PROFILE_FUNCTION() \
+  static profileSite profileSite_ = { __func__, 0 }; \
+  profileScope profileScope_ __attribute__((cleanup(profileScopeEnd))) = \
+    { profileSiteIndex(&profileSite_), profileTicks() }
+
+#else
+
+#define PROFILE_FUNCTION() (void)0
+
+#endif
@@ -0,0 +1,294 @@
+#pragma once
+
+/* Four-lane float and int vectors for the stream kernels.
+ *
+ * These are GCC vector extensions, so they become SSE or NEON where the
+ * target has it and plain scalar code elsewhere (e.g. the ARM11). Loads and
+ * stores go through memcpy and need no alignment.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "gs_math.h"
+
+typedef float v4f __attribute__((vector_size(16)));
+typedef s32   v4i __attribute__((vector_size(16)));
+
+static inline v4f
+v4fLoad(const float *p)
+{
+  v4f v;
+
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline void
+v4fStore(float *p, v4f v)
+{
+  memcpy(p, &v, sizeof(v));
+}
+
+static inline v4i
+v4iLoad(const s32 *p)
+{
+  v4i v;
+
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline void
+v4iStore(s32 *p, v4i v)
+{
+  memcpy(p, &v, sizeof(v));
+}
+
+static inline v4f
+v4fSplat(float f)
+{
+  return (v4f){ f, f, f, f };
+}
+
+/* all-ones lanes where alive[i] != 0 */
+static inline v4i
+v4iMask(const u8 *alive)
+{
+  v4i m = { alive[0], alive[1], alive[2], alive[3] };
+
+  return m != 0;
+}
+
+/* mask ? a : b per lane */
+static inline v4f
+v4fSelect(v4i mask, v4f a, v4f b)
+{
+  return (v4f)(((v4i)a & mask) | ((v4i)b & ~mask));
+}
+
+static inline v4f
+v4fMin(v4f a, v4f b)
+{
+  return v4fSelect(a < b, a, b);
+}
+
+static inline v4f
+v4fMax(v4f a, v4f b)
+{
+  return v4fSelect(a > b, a, b);
+}
+
+static inline v4f
+v4fClamp(v4f v, v4f lo, v4f hi)
+{
+  return v4fMin(v4fMax(v, lo), hi);
+}
+
+static inline v4f
+v4fAbs(v4f v)
+{
+  return (v4f)((v4i)v & (v4i){ 0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF });
+}
+
+/* bit k set where lane k of the mask is set */
+static inline unsigned
+v4iBits(v4i mask)
+{
+  return (mask[0] & 1) | (mask[1] & 2) | (mask[2] & 4) | (mask[3] & 8);
+}
+
+static inline v4f
+v4fSqrt(v4f v)
+{
+  int k;
+
+  for(k = 0; k < 4; ++k)
+    v[k] = sqrtf(v[k]);
+
+  return v;
+}
+
+/* load the first n lanes (n < 4 repeats p[0] in the rest) */
+static inline v4f
+v4fLoadN(const float *p, size_t n)
+{
+  v4f    v;
+  size_t k;
+
+  if(n >= 4)
+    return v4fLoad(p);
+
+  v = v4fSplat(p[0]);
+  for(k = 1; k < n; ++k)
+    v[k] = p[k];
+
+  return v;
+}
+
+/* store the first n lanes */
+static inline void
+v4fStoreN(float *p, v4f v, size_t n)
+{
+  size_t k;
+
+  if(n >= 4)
+  {
+    v4fStore(p, v);
+    return;
+  }
+
+  for(k = 0; k < n; ++k)
+    p[k] = v[k];
+}
+
+/* four vec3f's, one per lane */
+typedef struct
+{
+  v4f x, y, z;
+} v4f3;
+
+static inline v4f3
+v4f3LoadN(vec3fSoA s, size_t i, size_t n)
+{
+  return (v4f3){ v4fLoadN(s.x + i, n), v4fLoadN(s.y + i, n), v4fLoadN(s.z + i, n) };
+}
+
+static inline void
+v4f3StoreN(vec3fSoA s, size_t i, v4f3 v, size_t n)
+{
+  v4fStoreN(s.x + i, v.x, n);
+  v4fStoreN(s.y + i, v.y, n);
+  v4fStoreN(s.z + i, v.z, n);
+}
+
+static inline v4f3
+v4f3Splat(vec3f v)
+{
+  return (v4f3){ v4fSplat(v.x), v4fSplat(v.y), v4fSplat(v.z) };
+}
+
+/* set lane k */
+static inline void
+v4f3Insert(v4f3 *v, int k, vec3f p)
+{
+  v->x[k] = p.x;
+  v->y[k] = p.y;
+  v->z[k] = p.z;
+}
+
+/* lane k as a vec3f */
+static inline vec3f
+v4f3Extract(v4f3 v, int k)
+{
+  return (vec3f){ v.x[k], v.y[k], v.z[k] };
+}
+
+static inline v4f3
+v4f3Add(v4f3 a, v4f3 b)
+{
+  return (v4f3){ a.x + b.x, a.y + b.y, a.z + b.z };
+}
+
+static inline v4f3
+v4f3Subtract(v4f3 a, v4f3 b)
+{
+  return (v4f3){ a.x - b.x, a.y - b.y, a.z - b.z };
+}
+
+static inline v4f3
+v4f3Scale(v4f3 a, v4f s)
+{
+  return (v4f3){ a.x * s, a.y * s, a.z * s };
+}
+
+static inline v4f
+v4f3Dot(v4f3 a, v4f3 b)
+{
+  return a.x*b.x + a.y*b.y + a.z*b.z;
+}
+
+/* a*t^3 + b*t^2 + c*t + d by Horner's rule, as cubicEvaluate */
+static inline v4f3
+v4f3Cubic(v4f3 a, v4f3 b, v4f3 c, v4f3 d, v4f t)
+{
+  return (v4f3){ ((a.x*t + b.x)*t + c.x)*t + d.x,
+                 ((a.y*t + b.y)*t + c.y)*t + d.y,
+                 ((a.z*t + b.z)*t + c.z)*t + d.z };
+}
+
+static inline v4f3
+v4f3Cross(v4f3 a, v4f3 b)
+{
+  return (v4f3){ a.y*b.z - a.z*b.y, a.z*b.x - a.x*b.z, a.x*b.y - a.y*b.x };
+}
+
+static inline v4f3
+v4f3Select(v4i mask, v4f3 a, v4f3 b)
+{
+  return (v4f3){ v4fSelect(mask, a.x, b.x), v4fSelect(mask, a.y, b.y), v4fSelect(mask, a.z, b.z) };
+}
+
+/* contact between spheres at a and b, for the narrowphase kernels: the
+ * normal points from a to b (+Y if the centers coincide) and the point is
+ * midway between the two surfaces
+ */
+static inline v4f
+v4fSphereContact(v4f3 *normal, v4f3 *point, v4f3 a, v4f ra, v4f3 b, v4f rb)
+{
+  v4f3 d     = v4f3Subtract(b, a);
+  v4f  dist  = v4fSqrt(v4f3Dot(d, d));
+  v4i  apart = dist > v4fSplat(0.0f);
+  v4f  inv   = v4fSplat(1.0f) / v4fSelect(apart, dist, v4fSplat(1.0f));
+  v4f  depth = ra + rb - dist;
+
+  *normal = v4f3Select(apart, v4f3Scale(d, inv),
+                       (v4f3){ v4fSplat(0.0f), v4fSplat(1.0f), v4fSplat(0.0f) });
+  *point  = v4f3Add(a, v4f3Scale(*normal, ra - v4fSplat(0.5f)*depth));
+
+  return depth;
+}
+
+/* Moller-Trumbore per lane, as in rayTriangle; lanes that miss get
+ * INFINITY
+ */
+static inline v4f
+v4fRayTriangle(v4f3 o, v4f3 d, v4f3 v0, v4f3 v1, v4f3 v2)
+{
+  const v4f zero = v4fSplat(0.0f), one = v4fSplat(1.0f);
+
+  v4f3 e1  = v4f3Subtract(v1, v0);
+  v4f3 e2  = v4f3Subtract(v2, v0);
+  v4f3 p   = v4f3Cross(d, e2);
+  v4f3 s   = v4f3Subtract(o, v0);
+  v4f3 q   = v4f3Cross(s, e1);
+  v4f  det = v4f3Dot(e1, p);
+  v4f  inv = one / det;
+  v4f  u   = v4f3Dot(s, p) * inv;
+  v4f  v   = v4f3Dot(d, q) * inv;
+  v4f  t   = v4f3Dot(e2, q) * inv;
+
+  v4i hit = (v4fAbs(det) >= v4fSplat(1e-12f))
+          & (u >= zero) & (v >= zero) & (u + v <= one) & (t >= zero);
+
+  return v4fSelect(hit, t, v4fSplat(INFINITY));
+}
+
+/* slab test per lane, as in rayAabb; returns the entry distance clamped
+ * to 0, or INFINITY on a miss
+ */
+static inline v4f
+v4fRayAabb(v4f3 o, v4f3 inv, v4f3 min, v4f3 max)
+{
+  v4f3 t1 = { (min.x - o.x) * inv.x, (min.y - o.y) * inv.y, (min.z - o.z) * inv.z };
+  v4f3 t2 = { (max.x - o.x) * inv.x, (max.y - o.y) * inv.y, (max.z - o.z) * inv.z };
+  v4f  tn = v4fSplat(0.0f);
+  v4f  tf = v4fSplat(INFINITY);
+  v4i  m;
+
+  /* the same compares as rayAabb, so NaN slabs are skipped the same way */
+  m = t1.x < t2.x; tn = v4fMax(v4fSelect(m, t1.x, t2.x), tn); tf = v4fMin(v4fSelect(m, t2.x, t1.x), tf);
+  m = t1.y < t2.y; tn = v4fMax(v4fSelect(m, t1.y, t2.y), tn); tf = v4fMin(v4fSelect(m, t2.y, t1.y), tf);
+  m = t1.z < t2.z; tn = v4fMax(v4fSelect(m, t1.z, t2.z), tn); tf = v4fMin(v4fSelect(m, t2.z, t1.z), tf);
+
+  return v4fSelect(tn <= tf, tn, v4fSplat(INFINITY));
+}
@@ -0,0 +1,21 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void hashGridAssign(hashGrid *g, const vec3f *positions, size_t first, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  float  inv = g->invCellSize;
+  size_t i;
+
+  for(i = first; i < first + count; ++i)
+  {
+    vec3i cell = { (s32)floorf(positions[i].x * inv),
+                   (s32)floorf(positions[i].y * inv),
+                   (s32)floorf(positions[i].z * inv) };
+
+    g->cells[i]  = cell;
+    g->hashes[i] = hashGridHash(cell);
+  }
+}
@@ -0,0 +1,26 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+size_t hashGridCell(const hashGrid *g, vec3i cell, const s32 **entries)
+{
+  PROFILE_FUNCTION();
+
+  size_t mask = g->slotCount - 1;
+  size_t s;
+
+  if(g->slotCount == 0)
+    return 0;
+
+  for(s = hashGridHash(cell) & mask; g->slots[s].count != 0; s = (s + 1) & mask)
+  {
+    if(g->slots[s].cell.x == cell.x
+    && g->slots[s].cell.y == cell.y
+    && g->slots[s].cell.z == cell.z)
+    {
+      *entries = &g->entries[g->slots[s].first];
+      return g->slots[s].count;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,44 @@
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void hashGridCommit(hashGrid *g)
+{
+  PROFILE_FUNCTION();
+
+  size_t mask = g->slotCount - 1;
+  size_t i;
+  u32    total = 0;
+
+  memset(g->slots, 0, g->slotCount * sizeof(hashGridSlot));
+
+  /* count objects per cell; the object's hash is replaced by its slot */
+  for(i = 0; i < g->objectCount; ++i)
+  {
+    vec3i  cell = g->cells[i];
+    size_t s    = g->hashes[i] & mask;
+
+    while(g->slots[s].count != 0
+       && (g->slots[s].cell.x != cell.x
+        || g->slots[s].cell.y != cell.y
+        || g->slots[s].cell.z != cell.z))
+      s = (s + 1) & mask;
+
+    g->slots[s].cell = cell;
+    ++g->slots[s].count;
+    g->hashes[i] = (u32)s;
+  }
+
+  /* point each slot at the end of its range... */
+  for(i = 0; i < g->slotCount; ++i)
+  {
+    total += g->slots[i].count;
+    g->slots[i].first = total;
+  }
+
+  /* ...and scatter backwards, which leaves it at the start and keeps each
+   * cell's objects in index order
+   */
+  for(i = g->objectCount; i-- > 0; )
+    g->entries[--g->slots[g->hashes[i]].first] = (s32)i;
+}
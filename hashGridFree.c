@@ -0,0 +1,15 @@
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void hashGridFree(hashGrid *g)
+{
+  PROFILE_FUNCTION();
+
+  free(g->slots);
+  free(g->entries);
+  free(g->cells);
+  free(g->hashes);
+
+  hashGridInit(g, g->cellSize);
+}
@@ -0,0 +1,18 @@
+#include <stddef.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void hashGridInit(hashGrid *g, float cellSize)
+{
+  PROFILE_FUNCTION();
+
+  g->cellSize    = cellSize;
+  g->invCellSize = 1.0f / cellSize;
+  g->slots       = NULL;
+  g->slotCount   = 0;
+  g->entries     = NULL;
+  g->cells       = NULL;
+  g->hashes      = NULL;
+  g->objectCount = 0;
+  g->capacity    = 0;
+}
@@ -0,0 +1,34 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+size_t hashGridQuery(const hashGrid *g, vec3f position, s32 *out, size_t max)
+{
+  PROFILE_FUNCTION();
+
+  vec3i  c = { (s32)floorf(position.x * g->invCellSize),
+               (s32)floorf(position.y * g->invCellSize),
+               (s32)floorf(position.z * g->invCellSize) };
+  size_t found = 0;
+  int    x, y, z;
+
+  for(z = -1; z <= 1; ++z)
+  {
+    for(y = -1; y <= 1; ++y)
+    {
+      for(x = -1; x <= 1; ++x)
+      {
+        const s32 *entries;
+        size_t    i, n = hashGridCell(g, (vec3i){ c.x + x, c.y + y, c.z + z }, &entries);
+
+        for(i = 0; i < n; ++i, ++found)
+        {
+          if(found < max)
+            out[found] = entries[i];
+        }
+      }
+    }
+  }
+
+  return found;
+}
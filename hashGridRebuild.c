@@ -0,0 +1,15 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int hashGridRebuild(hashGrid *g, const vec3f *positions, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  if(!hashGridReserve(g, count))
+    return 0;
+
+  hashGridAssign(g, positions, 0, count);
+  hashGridCommit(g);
+
+  return 1;
+}
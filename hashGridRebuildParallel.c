@@ -0,0 +1,30 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+typedef struct
+{
+  hashGrid    *g;
+  const vec3f *positions;
+} args;
+
+static void
+run(void *p, size_t first, size_t count)
+{
+  args *a = p;
+  hashGridAssign(a->g, a->positions, first, count);
+}
+
+int hashGridRebuildParallel(threadPool *pool, hashGrid *g, const vec3f *positions, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  args a = { g, positions };
+
+  if(!hashGridReserve(g, count))
+    return 0;
+
+  threadPoolFor(pool, count, sizeof(vec3i), run, &a);
+  hashGridCommit(g);
+
+  return 1;
+}
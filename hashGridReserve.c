@@ -0,0 +1,42 @@
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int hashGridReserve(hashGrid *g, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t slotCount = 16;
+
+  if(count <= g->capacity)
+  {
+    g->objectCount = count;
+    return 1;
+  }
+
+  /* at least twice as many slots as objects keeps the load under half */
+  while(slotCount < count*2)
+    slotCount *= 2;
+
+  free(g->slots);
+  free(g->entries);
+  free(g->cells);
+  free(g->hashes);
+
+  g->slots   = malloc(slotCount * sizeof(hashGridSlot));
+  g->entries = malloc(count * sizeof(s32));
+  g->cells   = malloc(count * sizeof(vec3i));
+  g->hashes  = malloc(count * sizeof(u32));
+
+  if(!g->slots || !g->entries || !g->cells || !g->hashes)
+  {
+    hashGridFree(g);
+    return 0;
+  }
+
+  g->slotCount   = slotCount;
+  g->capacity    = count;
+  g->objectCount = count;
+
+  return 1;
+}
@@ -1,13 +1,20 @@
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <random>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 
 #include "gs_math.h"
+#include "gs_math.hpp"
 
 typedef std::mt19937                          generator_t;
 typedef std::uniform_real_distribution<float> distribution_t;
@@ -429,6 +436,2034 @@ check_quaternion(generator_t &gen, distribution_t &dist)
   }
 }
 
+static inline bool
+contains(const aabb &box, const vec3f &p)
+{
+  return p.x >= box.min.x - 0.001f && p.x <= box.max.x + 0.001f
+      && p.y >= box.min.y - 0.001f && p.y <= box.max.y + 0.001f
+      && p.z >= box.min.z - 0.001f && p.z <= box.max.z + 0.001f;
+}
+
+static void
+check_bounds(generator_t &gen, distribution_t &dist)
+{
+  for(size_t x = 0; x < 1000; ++x)
+  {
+    std::vector<vec3f> points(1 + x % 37);
+    for(auto &p: points)
+      p = (vec3f){ dist(gen), dist(gen), dist(gen) };
+
+    // check aabb
+    aabb box;
+    aabbFromPoints(&box, points.data(), points.size());
+    {
+      vec3f lo = points[0], hi = points[0];
+      for(auto &p: points)
+      {
+        lo = (vec3f){ std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z) };
+        hi = (vec3f){ std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z) };
+      }
+
+      assert(box.min == glm::vec3(lo.x, lo.y, lo.z));
+      assert(box.max == glm::vec3(hi.x, hi.y, hi.z));
+    }
+
+    // check aabb transform against the transformed points
+    {
+      mtx44 m;
+      mtx44Identity(&m);
+      mtx44Translate(&m, dist(gen), dist(gen), dist(gen));
+      mtx44Rotate(&m, (vec3f){ dist(gen), dist(gen), dist(gen) }, randomAngle(gen, dist));
+      mtx44Scale(&m, dist(gen), dist(gen), dist(gen));
+
+      aabb out;
+      aabbTransform(&out, &box, &m);
+
+      glm::mat4 g = loadMatrix(m);
+      for(auto &p: points)
+      {
+        glm::vec4 t = g * glm::vec4(p.x, p.y, p.z, 1.0f);
+        assert(contains(out, (vec3f){ t.x, t.y, t.z }));
+      }
+
+      for(int c = 0; c < 8; ++c)
+      {
+        glm::vec4 t = g * glm::vec4(c & 1 ? box.max.x : box.min.x,
+                                    c & 2 ? box.max.y : box.min.y,
+                                    c & 4 ? box.max.z : box.min.z,
+                                    1.0f);
+        assert(contains(out, (vec3f){ t.x, t.y, t.z }));
+      }
+    }
+
+    // check sphere
+    {
+      sphere s;
+      sphereFromPoints(&s, points.data(), points.size());
+      for(auto &p: points)
+      {
+        vec3f d = vec3fSubtract(p, s.center);
+        assert(std::sqrt(vec3fDot(d, d)) <= s.radius * 1.0001f + 0.001f);
+      }
+    }
+
+    // check obb
+    {
+      obb o;
+      obbFromPoints(&o, points.data(), points.size());
+
+      assert(std::abs(vec3fDot(o.axis[0], o.axis[1])) < 0.001f);
+      assert(std::abs(vec3fDot(o.axis[0], o.axis[2])) < 0.001f);
+      assert(std::abs(vec3fDot(o.axis[1], o.axis[2])) < 0.001f);
+
+      for(auto &p: points)
+      {
+        vec3f d = vec3fSubtract(p, o.center);
+        assert(std::abs(vec3fDot(d, o.axis[0])) <= o.extent.x + 0.001f);
+        assert(std::abs(vec3fDot(d, o.axis[1])) <= o.extent.y + 0.001f);
+        assert(std::abs(vec3fDot(d, o.axis[2])) <= o.extent.z + 0.001f);
+      }
+    }
+  }
+
+  // check batch forms against the single forms
+  {
+    std::vector<vec3f>  points(200);
+    std::vector<size_t> offsets = { 0, 1, 17, 17, 120, 200 };
+    for(auto &p: points)
+      p = (vec3f){ dist(gen), dist(gen), dist(gen) };
+
+    size_t count = offsets.size() - 1;
+    std::vector<aabb>   boxes(count);
+    std::vector<sphere> spheres(count);
+    std::vector<obb>    obbs(count);
+
+    aabbFromPointsBatch(boxes.data(), points.data(), offsets.data(), count);
+    sphereFromPointsBatch(spheres.data(), points.data(), offsets.data(), count);
+    obbFromPointsBatch(obbs.data(), points.data(), offsets.data(), count);
+
+    for(size_t i = 0; i < count; ++i)
+    {
+      aabb   box;
+      sphere s;
+      obb    o;
+
+      aabbFromPoints(&box, &points[offsets[i]], offsets[i+1] - offsets[i]);
+      sphereFromPoints(&s, &points[offsets[i]], offsets[i+1] - offsets[i]);
+      obbFromPoints(&o, &points[offsets[i]], offsets[i+1] - offsets[i]);
+
+      assert(std::memcmp(&box, &boxes[i], sizeof(box)) == 0);
+      assert(std::memcmp(&s, &spheres[i], sizeof(s)) == 0);
+      assert(std::memcmp(&o, &obbs[i], sizeof(o)) == 0);
+    }
+
+    std::vector<mtx44> m(count);
+    std::vector<aabb>  out(count);
+    for(auto &mtx: m)
+      randomMatrix(mtx, gen, dist);
+
+    aabbTransformBatch(out.data(), boxes.data(), m.data(), count);
+    for(size_t i = 0; i < count; ++i)
+    {
+      aabb box;
+      aabbTransform(&box, &boxes[i], &m[i]);
+      assert(std::memcmp(&box, &out[i], sizeof(box)) == 0);
+    }
+  }
+}
+
+static void
+check_rays(generator_t &gen, distribution_t &dist)
+{
+  // check known hits
+  {
+    ray  r = { { 0.25f, 0.25f, -2.0f }, { 0.0f, 0.0f, 0.5f } };
+    aabb b = { { 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 2.0f } };
+    float t, u, v, near, far;
+
+    assert(rayTriangle(&r, (vec3f){ 0.0f, 0.0f, 0.0f },
+                           (vec3f){ 1.0f, 0.0f, 0.0f },
+                           (vec3f){ 0.0f, 1.0f, 0.0f }, &t, &u, &v));
+    assert(std::abs(t - 4.0f) < 0.0001f);
+    assert(std::abs(u - 0.25f) < 0.0001f && std::abs(v - 0.25f) < 0.0001f);
+
+    assert(!rayTriangle(&r, (vec3f){ 1.0f, 1.0f, 0.0f },
+                            (vec3f){ 2.0f, 1.0f, 0.0f },
+                            (vec3f){ 1.0f, 2.0f, 0.0f }, &t, &u, &v));
+
+    assert(rayAabb(&r, &b, &near, &far));
+    assert(std::abs(near - 6.0f) < 0.0001f && std::abs(far - 8.0f) < 0.0001f);
+
+    // a zero direction component with the origin on that slab's plane makes
+    // the slab NaN; every form must treat it the same way
+    ray  flat = { { 0.0f, 0.25f, -2.0f }, { -0.0f, 0.0f, 0.5f } };
+    ray4 r4   = {};
+    ray8 r8   = {};
+    for(int k = 0; k < 4; ++k)
+    {
+      r4.oy[k] = 0.25f; r4.oz[k] = -2.0f; r4.dx[k] = -0.0f; r4.dz[k] = 0.5f;
+    }
+    for(int k = 0; k < 8; ++k)
+    {
+      r8.oy[k] = 0.25f; r8.oz[k] = -2.0f; r8.dx[k] = -0.0f; r8.dz[k] = 0.5f;
+    }
+
+    float t4[4], t8[8];
+    std::fill(t4, t4+4, INFINITY);
+    std::fill(t8, t8+8, INFINITY);
+
+    assert(rayAabb(&flat, &b, &near, nullptr));
+    rayAabbBatch(&t, &flat, &b, 1);
+    assert(t == near);
+    assert(ray4Aabb(t4, &r4, &b) == 0xF);
+    assert(ray8Aabb(t8, &r8, &b) == 0xFF);
+  }
+
+  for(size_t x = 0; x < 1000; ++x)
+  {
+    std::vector<vec3f> tris(3*16);
+    std::vector<aabb>  boxes(16);
+    for(auto &p: tris)
+      p = (vec3f){ dist(gen), dist(gen), dist(gen) };
+    for(size_t i = 0; i < boxes.size(); ++i)
+      aabbFromPoints(&boxes[i], &tris[3*i], 3);
+
+    ray8 r8;
+    for(int k = 0; k < 8; ++k)
+    {
+      r8.ox[k] = dist(gen); r8.oy[k] = dist(gen); r8.oz[k] = dist(gen);
+      r8.dx[k] = dist(gen); r8.dy[k] = dist(gen); r8.dz[k] = dist(gen);
+    }
+
+    ray4 r4;
+    for(int k = 0; k < 4; ++k)
+    {
+      r4.ox[k] = r8.ox[k]; r4.oy[k] = r8.oy[k]; r4.oz[k] = r8.oz[k];
+      r4.dx[k] = r8.dx[k]; r4.dy[k] = r8.dy[k]; r4.dz[k] = r8.dz[k];
+    }
+
+    float t8[8], t4[4];
+    std::fill(t8, t8+8, INFINITY);
+    std::fill(t4, t4+4, INFINITY);
+
+    for(int k = 0; k < 8; ++k)
+    {
+      ray r = { { r8.ox[k], r8.oy[k], r8.oz[k] }, { r8.dx[k], r8.dy[k], r8.dz[k] } };
+
+      float tri[16], box[16];
+      rayTriangleBatch(tri, &r, tris.data(), 16);
+      rayAabbBatch(box, &r, boxes.data(), 16);
+
+      for(size_t i = 0; i < 16; ++i)
+      {
+        float t, near;
+        bool  hit = rayTriangle(&r, tris[3*i], tris[3*i+1], tris[3*i+2], &t, nullptr, nullptr);
+        assert(hit == !std::isinf(tri[i]));
+        assert(!hit || std::abs(t - tri[i]) < 0.0001f);
+
+        // a triangle hit implies a hit on its bounds, no further away
+        assert(!hit || box[i] <= tri[i] + 0.0001f);
+
+        hit = rayAabb(&r, &boxes[i], &near, nullptr);
+        assert(hit == !std::isinf(box[i]));
+        assert(!hit || std::abs(near - box[i]) < 0.0001f);
+      }
+    }
+
+    // check packets against the single-ray forms
+    for(size_t i = 0; i < 16; ++i)
+    {
+      unsigned m8 = ray8Aabb(t8, &r8, &boxes[i]);
+      unsigned m4 = ray4Aabb(t4, &r4, &boxes[i]);
+      assert((m8 & 0xF) == m4);
+
+      for(int k = 0; k < 8; ++k)
+      {
+        ray   r = { { r8.ox[k], r8.oy[k], r8.oz[k] }, { r8.dx[k], r8.dy[k], r8.dz[k] } };
+        float near;
+        bool  hit = rayAabb(&r, &boxes[i], &near, nullptr) && near < t8[k];
+        assert(hit == !!(m8 & (1u << k)));
+      }
+
+      float old[8];
+      std::copy(t8, t8+8, old);
+      m8 = ray8Triangle(t8, &r8, tris[3*i], tris[3*i+1], tris[3*i+2]);
+      m4 = ray4Triangle(t4, &r4, tris[3*i], tris[3*i+1], tris[3*i+2]);
+      assert((m8 & 0xF) == m4);
+
+      for(int k = 0; k < 8; ++k)
+      {
+        ray   r = { { r8.ox[k], r8.oy[k], r8.oz[k] }, { r8.dx[k], r8.dy[k], r8.dz[k] } };
+        float t;
+        bool  hit = rayTriangle(&r, tris[3*i], tris[3*i+1], tris[3*i+2], &t, nullptr, nullptr)
+                 && t < old[k];
+        assert(hit == !!(m8 & (1u << k)));
+        assert(!hit || std::abs(t8[k] - t) < 0.0001f);
+        assert(hit || t8[k] == old[k]);
+        assert(k >= 4 || t4[k] == t8[k]);
+      }
+    }
+  }
+}
+
+static void
+check_bvh(generator_t &gen, distribution_t &dist)
+{
+  for(size_t count: { 0, 1, 3, 4, 5, 37, 1000 })
+  {
+    // random small triangles
+    std::vector<vec3f> tris(3*count);
+    for(size_t i = 0; i < count; ++i)
+    {
+      vec3f c = { dist(gen), dist(gen), dist(gen) };
+      for(int k = 0; k < 3; ++k)
+        tris[3*i+k] = vec3fAdd(c, (vec3f){ dist(gen) * 0.1f, dist(gen) * 0.1f, dist(gen) * 0.1f });
+    }
+
+    bvh b;
+    assert(bvhBuildTriangles(&b, tris.data(), count));
+    assert(b.primCount == count);
+    assert(b.nodeCount >= 1 && b.nodeCount <= std::max<size_t>(count, 1));
+
+    for(int pass = 0; pass < 2; ++pass)
+    {
+      std::vector<aabb> boxes(count);
+      for(size_t i = 0; i < count; ++i)
+        aabbFromPoints(&boxes[i], &tris[3*i], 3);
+
+      for(size_t x = 0; x < 100; ++x)
+      {
+        ray r = { { dist(gen), dist(gen), dist(gen) }, { dist(gen), dist(gen), dist(gen) } };
+
+        // check against a linear scan
+        float best = INFINITY;
+        s32   bestPrim = -1;
+        for(size_t i = 0; i < count; ++i)
+        {
+          float t;
+          if(rayTriangle(&r, tris[3*i], tris[3*i+1], tris[3*i+2], &t, nullptr, nullptr) && t < best)
+          {
+            best     = t;
+            bestPrim = (s32)i;
+          }
+        }
+
+        float t = INFINITY;
+        s32   prim;
+        int   hit = bvhClosestHit(&b, &r, tris.data(), &t, &prim);
+        assert(hit == (bestPrim >= 0));
+        assert(!hit || (t == best && prim == bestPrim));
+
+        assert(bvhAnyHit(&b, &r, tris.data(), INFINITY) == hit);
+        assert(!hit || !bvhAnyHit(&b, &r, tris.data(), best));
+
+        aabb q = { { dist(gen), dist(gen), dist(gen) }, {} };
+        q.max = vec3fAdd(q.min, (vec3f){ 3.0f, 3.0f, 3.0f });
+
+        std::vector<s32> expected;
+        for(size_t i = 0; i < count; ++i)
+        {
+          if(boxes[i].min.x <= q.max.x && boxes[i].max.x >= q.min.x
+          && boxes[i].min.y <= q.max.y && boxes[i].max.y >= q.min.y
+          && boxes[i].min.z <= q.max.z && boxes[i].max.z >= q.min.z)
+            expected.push_back((s32)i);
+        }
+
+        std::vector<s32> found(count);
+        size_t n = bvhOverlap(&b, boxes.data(), &q, found.data(), found.size());
+        assert(n == expected.size());
+        std::sort(found.begin(), found.begin() + n);
+        assert(std::equal(expected.begin(), expected.end(), found.begin()));
+
+        assert(bvhOverlap(&b, nullptr, &q, nullptr, 0) >= n);
+      }
+
+      // move everything and refit
+      vec3f offset = { dist(gen), dist(gen), dist(gen) };
+      for(size_t i = 0; i < tris.size(); ++i)
+        tris[i] = vec3fAdd(tris[i], vec3fScale(offset, (float)(i / 3 % 7) * 0.1f));
+      bvhRefitTriangles(&b, tris.data());
+
+      // refitting from primitive bounds gives the same nodes
+      std::vector<bvhNode> nodes(b.nodes, b.nodes + b.nodeCount);
+      for(size_t i = 0; i < count; ++i)
+        aabbFromPoints(&boxes[i], &tris[3*i], 3);
+      bvhRefit(&b, boxes.data());
+      assert(std::memcmp(nodes.data(), b.nodes, b.nodeCount * sizeof(bvhNode)) == 0);
+    }
+
+    bvhFree(&b);
+  }
+}
+
+static void
+check_morton(generator_t &gen)
+{
+  std::uniform_int_distribution<s32> coord(-0x100000, 0xFFFFF);
+
+  std::vector<vec3i> v(1000), w(1000), out(1000);
+  std::vector<u64>   codes(1000);
+  for(size_t i = 0; i < v.size(); ++i)
+  {
+    v[i] = (vec3i){ coord(gen), coord(gen), coord(gen) };
+    w[i] = (vec3i){ coord(gen) >> 10, coord(gen) >> 10, coord(gen) >> 10 };
+  }
+
+  // check against a bit-by-bit interleave
+  for(auto &p: v)
+  {
+    u64 expected = 0;
+    for(int b = 0; b < 21; ++b)
+    {
+      expected |= (u64)((p.x + 0x100000) >> b & 1) << (3*b + 0);
+      expected |= (u64)((p.y + 0x100000) >> b & 1) << (3*b + 1);
+      expected |= (u64)((p.z + 0x100000) >> b & 1) << (3*b + 2);
+    }
+
+    assert(vec3iToMorton(p) == expected);
+
+    vec3i q = mortonToVec3i(expected);
+    assert(q.x == p.x && q.y == p.y && q.z == p.z);
+  }
+
+  // check ordering across the sign boundary
+  assert(vec3iToMorton((vec3i){ -1, -1, -1 }) < vec3iToMorton((vec3i){ 0, 0, 0 }));
+
+  vec3iToMortonBatch(codes.data(), v.data(), v.size());
+  mortonToVec3iBatch(out.data(), codes.data(), codes.size());
+  for(size_t i = 0; i < v.size(); ++i)
+  {
+    assert(codes[i] == vec3iToMorton(v[i]));
+    assert(std::memcmp(&out[i], &v[i], sizeof(vec3i)) == 0);
+  }
+
+  // check batch arithmetic
+  vec3iAddBatch(out.data(), v.data(), w.data(), v.size());
+  for(size_t i = 0; i < v.size(); ++i)
+  {
+    vec3i e = vec3iAdd(v[i], w[i]);
+    assert(std::memcmp(&out[i], &e, sizeof(vec3i)) == 0);
+  }
+
+  vec3iSubtractBatch(out.data(), v.data(), w.data(), v.size());
+  for(size_t i = 0; i < v.size(); ++i)
+  {
+    vec3i e = vec3iSubtract(v[i], w[i]);
+    assert(std::memcmp(&out[i], &e, sizeof(vec3i)) == 0);
+  }
+
+  vec3iScaleBatch(out.data(), w.data(), -7, w.size());
+  for(size_t i = 0; i < w.size(); ++i)
+  {
+    vec3i e = vec3iScale(w[i], -7);
+    assert(std::memcmp(&out[i], &e, sizeof(vec3i)) == 0);
+  }
+
+  // in place, with a count that leaves a scalar tail
+  out = v;
+  vec3iAddBatch(out.data(), out.data(), w.data(), 999);
+  for(size_t i = 0; i < v.size(); ++i)
+  {
+    vec3i e = i < 999 ? vec3iAdd(v[i], w[i]) : v[i];
+    assert(std::memcmp(&out[i], &e, sizeof(vec3i)) == 0);
+  }
+
+  vec3iCrossBatch(out.data(), w.data(), w.data() + 1, w.size() - 1);
+  for(size_t i = 0; i < w.size() - 1; ++i)
+  {
+    vec3i e = vec3iCross(w[i], w[i+1]);
+    assert(std::memcmp(&out[i], &e, sizeof(vec3i)) == 0);
+  }
+}
+
+static void
+check_hash_grid(generator_t &gen, distribution_t &dist)
+{
+  hashGrid g;
+  hashGridInit(&g, 1.5f);
+
+  for(size_t count: { 0, 1, 100, 5000, 200 })
+  {
+    std::vector<vec3f> positions(count);
+    for(auto &p: positions)
+      p = (vec3f){ dist(gen), dist(gen), dist(gen) };
+
+    assert(hashGridRebuild(&g, positions.data(), count));
+
+    // every object is found in its own cell
+    for(size_t i = 0; i < count; ++i)
+    {
+      const s32 *entries;
+      size_t n = hashGridCell(&g, g.cells[i], &entries);
+      assert(std::find(entries, entries + n, (s32)i) != entries + n);
+    }
+
+    // check neighbor queries against a linear scan
+    for(size_t x = 0; x < 100; ++x)
+    {
+      vec3f p = { dist(gen), dist(gen), dist(gen) };
+      vec3i c = { (s32)std::floor(p.x / 1.5f), (s32)std::floor(p.y / 1.5f), (s32)std::floor(p.z / 1.5f) };
+
+      std::vector<s32> expected;
+      for(size_t i = 0; i < count; ++i)
+      {
+        if(std::abs(g.cells[i].x - c.x) <= 1
+        && std::abs(g.cells[i].y - c.y) <= 1
+        && std::abs(g.cells[i].z - c.z) <= 1)
+          expected.push_back((s32)i);
+      }
+
+      std::vector<s32> found(count);
+      size_t n = hashGridQuery(&g, p, found.data(), found.size());
+      assert(n == expected.size());
+      std::sort(found.begin(), found.begin() + n);
+      assert(std::equal(expected.begin(), expected.end(), found.begin()));
+    }
+  }
+
+  hashGridFree(&g);
+}
+
+static void
+check_thread_pool(generator_t &gen, distribution_t &dist)
+{
+  threadPool *pool = threadPoolCreate(4);
+  assert(pool && threadPoolSize(pool) == 4);
+
+  // every index is visited exactly once
+  for(size_t count: { 0, 1, 31, 1000, 100003 })
+  {
+    for(size_t size: { 1, 12, 64 })
+    {
+      std::vector<int> hits(count);
+      threadPoolFor(pool, count, size, [](void *arg, size_t first, size_t n)
+      {
+        int *hits = static_cast<int*>(arg);
+        for(size_t i = first; i < first + n; ++i)
+          ++hits[i];
+      }, hits.data());
+
+      assert(std::count(hits.begin(), hits.end(), 1) == (ptrdiff_t)count);
+    }
+  }
+
+  // check parallel batches against the serial ones
+  size_t count = 10000;
+  std::vector<mtx44> m1(count), m2(count), r1(count), r2(count);
+  std::vector<quat>  q1(count), q2(count), s1(count), s2(count);
+  std::vector<vec3f> v(count), o1(count), o2(count);
+  for(size_t i = 0; i < count; ++i)
+  {
+    randomMatrix(m1[i], gen, dist);
+    randomMatrix(m2[i], gen, dist);
+    q1[i] = randomQuat(gen, dist);
+    q2[i] = randomQuat(gen, dist);
+    v[i]  = (vec3f){ dist(gen), dist(gen), dist(gen) };
+  }
+
+  mtx44MultiplyBatch(r1.data(), m1.data(), m2.data(), count);
+  mtx44MultiplyBatchParallel(pool, r2.data(), m1.data(), m2.data(), count);
+  assert(std::memcmp(r1.data(), r2.data(), count * sizeof(mtx44)) == 0);
+
+  for(size_t i = 0; i < count; i += 97)
+  {
+    mtx44 m;
+    mtx44Multiply(&m, &m1[i], &m2[i]);
+    assert(std::memcmp(&m, &r1[i], sizeof(m)) == 0);
+  }
+
+  mtx44TransformBatch(o1.data(), &m1[0], v.data(), count);
+  mtx44TransformBatchParallel(pool, o2.data(), &m1[0], v.data(), count);
+  assert(std::memcmp(o1.data(), o2.data(), count * sizeof(vec3f)) == 0);
+
+  glm::mat4 g = loadMatrix(m1[0]);
+  for(size_t i = 0; i < count; i += 97)
+  {
+    glm::vec4 t = g * glm::vec4(v[i].x, v[i].y, v[i].z, 1.0f);
+    assert(std::abs(t.x - o1[i].x) < 0.01f && std::abs(t.y - o1[i].y) < 0.01f && std::abs(t.z - o1[i].z) < 0.01f);
+  }
+
+  quatMultiplyBatch(s1.data(), q1.data(), q2.data(), count);
+  quatMultiplyBatchParallel(pool, s2.data(), q1.data(), q2.data(), count);
+  assert(std::memcmp(s1.data(), s2.data(), count * sizeof(quat)) == 0);
+  for(size_t i = 0; i < count; i += 97)
+    assert(s1[i] == loadQuat(q1[i]) * loadQuat(q2[i]));
+
+  quatToMtx44Batch(r1.data(), q1.data(), count);
+  quatToMtx44BatchParallel(pool, r2.data(), q1.data(), count);
+  assert(std::memcmp(r1.data(), r2.data(), count * sizeof(mtx44)) == 0);
+  for(size_t i = 0; i < count; i += 97)
+    assert(r1[i] == glm::mat4_cast(loadQuat(q1[i])));
+
+  // check the parallel grid rebuild against the serial one
+  hashGrid h1, h2;
+  hashGridInit(&h1, 2.0f);
+  hashGridInit(&h2, 2.0f);
+  assert(hashGridRebuild(&h1, v.data(), count));
+  assert(hashGridRebuildParallel(pool, &h2, v.data(), count));
+  assert(h1.slotCount == h2.slotCount);
+  assert(std::memcmp(h1.slots, h2.slots, h1.slotCount * sizeof(hashGridSlot)) == 0);
+  assert(std::memcmp(h1.entries, h2.entries, count * sizeof(s32)) == 0);
+  hashGridFree(&h1);
+  hashGridFree(&h2);
+
+  threadPoolDestroy(pool);
+}
+
+static void
+check_arena(generator_t &gen, distribution_t &dist)
+{
+  static_assert(alignof(mtx44a) == 64, "mtx44a alignment");
+  static_assert(alignof(quata) == 16, "quata alignment");
+  static_assert(sizeof(vec4f) == 16 && alignof(vec4f) == 16, "vec4f layout");
+
+  arena a;
+  assert(arenaInit(&a, 4096));
+
+  for(int frame = 0; frame < 3; ++frame)
+  {
+    arenaReset(&a);
+
+    char   *c = (char*)arenaAlloc(&a, 3, 1);
+    mtx44a *m = arenaAllocMtx44(&a, 4);
+    quata  *q = arenaAllocQuat(&a, 5);
+    vec4f  *v = arenaAllocVec4f(&a, 6);
+    assert(c && m && q && v);
+    assert((uintptr_t)m % 64 == 0);
+    assert((uintptr_t)q % 16 == 0);
+    assert((uintptr_t)v % 16 == 0);
+    assert((char*)m >= c + 3 && (char*)q >= (char*)(m + 4) && (char*)v >= (char*)(q + 5));
+
+    // the same layout every frame
+    assert(c == (char*)a.base);
+
+    // aligned types work with the existing functions
+    mtx44Identity(&m[0]);
+    assert(m[0] == glm::mat4());
+
+    assert(arenaAlloc(&a, 4096, 1) == nullptr);
+  }
+
+  arenaFree(&a);
+
+  // check the padded transform against the packed one
+  std::vector<vec3f> p(101), o(101), back(101);
+  std::vector<vec4f> p4(101), o4(101);
+  for(auto &x: p)
+    x = (vec3f){ dist(gen), dist(gen), dist(gen) };
+
+  mtx44 m;
+  randomMatrix(m, gen, dist);
+
+  vec3fToVec4fBatch(p4.data(), p.data(), 0.0f, p.size());
+  mtx44TransformVec4fBatch(o4.data(), &m, p4.data(), p4.size());
+  mtx44TransformBatch(o.data(), &m, p.data(), p.size());
+  vec4fToVec3fBatch(back.data(), o4.data(), o4.size());
+
+  for(size_t i = 0; i < p.size(); ++i)
+  {
+    assert(std::memcmp(&back[i], &o[i], sizeof(vec3f)) == 0);
+    assert(o4[i].w == 1.0f);
+  }
+}
+
+static void
+check_triple_buffer()
+{
+  const size_t count = 256;
+
+  tripleBuffer tb;
+  assert(tripleBufferInit(&tb, count * sizeof(mtx44)));
+
+  // nothing published yet
+  u64 frame;
+  tripleBufferAcquire(&tb, &frame);
+  assert(frame == 0);
+
+  // the reader always sees a whole, newer frame
+  const u64 frames = 20000;
+  std::thread writer([&]()
+  {
+    for(u64 f = 1; f <= frames; ++f)
+    {
+      mtx44 *m = static_cast<mtx44*>(tripleBufferWriteBuffer(&tb));
+      for(size_t i = 0; i < count; ++i)
+      {
+        for(size_t j = 0; j < 16; ++j)
+          m[i].v[j] = (float)f;
+      }
+
+      assert(tripleBufferPublish(&tb) == f);
+    }
+  });
+
+  u64 last = 0;
+  while(last < frames)
+  {
+    const mtx44 *m = static_cast<const mtx44*>(tripleBufferAcquire(&tb, &frame));
+    assert(frame >= last);
+
+    if(frame == 0)
+      continue;
+
+    for(size_t i = 0; i < count; ++i)
+    {
+      for(size_t j = 0; j < 16; ++j)
+        assert(m[i].v[j] == (float)frame);
+    }
+
+    last = frame;
+  }
+
+  writer.join();
+  tripleBufferFree(&tb);
+}
+
+static u32
+referenceF24(float f)
+{
+  // encode through frexp rather than bit manipulation
+  if(std::isnan(f))
+    return 0x7FFFFF;
+
+  u32 sign = std::signbit(f) ? 0x800000 : 0;
+  if(f == 0.0f)
+    return sign;
+
+  int   e;
+  float m   = std::frexp(std::abs(f), &e); // |f| = m * 2^e, m in [0.5, 1)
+  int   exp = e - 1 + 63;
+
+  if(std::isinf(f) || exp >= 0x7F)
+    return sign | 0x7F0000;
+  if(exp <= 0)
+    return sign;
+
+  u32 man = (u32)std::ldexp(m * 2.0f - 1.0f, 16);
+  return sign | (u32)exp << 16 | man;
+}
+
+static void
+check_pica(generator_t &gen, distribution_t &dist)
+{
+  // check the float24 encoder against the reference
+  for(float f: { 0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 3.14159f, 1e-19f, 1e-20f, -1e-30f,
+                 1e19f, 1e20f, -1e30f, INFINITY, -INFINITY, NAN })
+    assert(floatToF24(f) == referenceF24(f));
+
+  assert(floatToF24(1.0f) == 0x3F0000);
+  assert(floatToF24(-2.0f) == 0xC00000);
+
+  for(size_t x = 0; x < 100000; ++x)
+  {
+    float f = std::ldexp(dist(gen), (int)(gen() % 160) - 80);
+    assert(floatToF24(f) == referenceF24(f));
+  }
+
+  for(size_t count: { 1, 7, 15, 16, 20, 21, 45 })
+  {
+    std::vector<mtx44> m(count);
+    for(auto &x: m)
+      randomMatrix(x, gen, dist);
+
+    std::vector<u32> f32(count * 16), f24(count * 12);
+    mtx44ToPicaF32(f32.data(), m.data(), count);
+    mtx44ToPicaF24(f24.data(), m.data(), count);
+
+    for(size_t n = 0; n < count; ++n)
+    {
+      for(size_t row = 0; row < 4; ++row)
+      {
+        // rows in w, z, y, x order
+        for(size_t c = 0; c < 4; ++c)
+        {
+          u32 bits;
+          std::memcpy(&bits, &m[n].v[(3-c)*4+row], sizeof(bits));
+          assert(f32[n*16 + row*4 + c] == bits);
+        }
+
+        // packed float24: w, z, y, x from the most significant bit down
+        u32 x = referenceF24(m[n].v[0*4+row]);
+        u32 y = referenceF24(m[n].v[1*4+row]);
+        u32 z = referenceF24(m[n].v[2*4+row]);
+        u32 w = referenceF24(m[n].v[3*4+row]);
+        const u32 *p = &f24[n*12 + row*3];
+        assert(p[0] == ((w << 8) | (z >> 16)));
+        assert(p[1] == ((z << 16) | (y >> 8)));
+        assert(p[2] == ((y << 24) | x));
+      }
+    }
+
+    // commands: config write, then data writes of up to 240 words
+    for(int mode = 0; mode < 4; ++mode)
+    {
+      bool f24mode  = mode & 1;
+      bool geometry = mode & 2;
+      const std::vector<u32> &data = f24mode ? f24 : f32;
+
+      size_t size = mtx44ToPicaCommands(nullptr, m.data(), count, 5, f24mode, geometry);
+      std::vector<u32> cmd(size + 1, 0xDEADBEEF);
+      assert(mtx44ToPicaCommands(cmd.data(), m.data(), count, 5, f24mode, geometry) == size);
+      assert(size % 2 == 0 && cmd[size] == 0xDEADBEEF);
+
+      u32 config = geometry ? 0x0290 : 0x02C0;
+      assert(cmd[0] == ((f24mode ? 0 : 0x80000000) | 5));
+      assert(cmd[1] == (config | 0xF0000));
+
+      size_t pos = 2, word = 0;
+      while(pos < size)
+      {
+        u32 header = cmd[pos+1];
+        size_t n   = (header >> 20 & 0xFF) + 1;
+        assert((header & 0xFFFF) == config + 1 && (header >> 16 & 0xF) == 0xF);
+        assert(!(header & 0x80000000));
+
+        assert(cmd[pos] == data[word++]);
+        for(size_t i = 1; i < n; ++i)
+          assert(cmd[pos+1+i] == data[word++]);
+
+        pos += 1 + n + ((n - 1) & 1);
+      }
+
+      assert(pos == size && word == data.size());
+    }
+  }
+}
+
+static void
+check_normal_matrix(generator_t &gen, distribution_t &dist)
+{
+  for(size_t x = 0; x < 10000; ++x)
+  {
+    // a well-conditioned transform with non-uniform, possibly mirrored scale
+    mtx44 m;
+    mtx44Identity(&m);
+    mtx44Translate(&m, dist(gen), dist(gen), dist(gen));
+    mtx44Rotate(&m, (vec3f){ dist(gen), dist(gen), dist(gen) }, randomAngle(gen, dist));
+    mtx44Scale(&m, 1.0f + std::abs(dist(gen)), 1.0f + std::abs(dist(gen)),
+               (x & 1 ? -1.0f : 1.0f) * (1.0f + std::abs(dist(gen))));
+
+    glm::mat4 g = glm::transpose(glm::inverse(loadMatrix(m)));
+    for(int i = 0; i < 3; ++i)
+      g[i][3] = g[3][i] = 0.0f;
+    g[3][3] = 1.0f;
+
+    mtx44 n;
+    mtx44NormalMatrix(&n, &m);
+    assert(n == g);
+
+    mtx44 batch[2];
+    mtx44NormalMatrixBatch(batch, &m, 1);
+    assert(batch[0] == g);
+
+    // uniform scale
+    mtx44Identity(&m);
+    mtx44Rotate(&m, (vec3f){ dist(gen), dist(gen), dist(gen) }, randomAngle(gen, dist));
+    float s = 0.5f + std::abs(dist(gen));
+    mtx44Scale(&m, s, s, s);
+
+    mtx44NormalMatrix(&n, &m);
+    mtx44NormalMatrixUniform(&batch[1], &m);
+    assert(n == loadMatrix(batch[1]));
+  }
+}
+
+static void
+check_camera(generator_t &gen, distribution_t &dist)
+{
+  for(size_t x = 0; x < 1000; ++x)
+  {
+    glm::vec3 eye    = randomVector(gen, dist);
+    glm::vec3 target = randomVector(gen, dist);
+    glm::vec3 up     = randomVector(gen, dist);
+
+    float fovy   = 0.5f + std::abs(dist(gen)) * 0.1f;
+    float aspect = 0.5f + std::abs(dist(gen)) * 0.1f;
+    float near   = 0.1f + std::abs(dist(gen)) * 0.1f;
+    float far    = near + 1.0f + std::abs(dist(gen)) * 10.0f;
+
+    // check the underlying builders
+    mtx44 m;
+    mtx44LookAt(&m, (vec3f){ eye.x, eye.y, eye.z }, (vec3f){ target.x, target.y, target.z },
+                (vec3f){ up.x, up.y, up.z });
+    glm::mat4 view = glm::lookAt(eye, target, up);
+    assert(m == view);
+
+    // aspect is y/x here but x/y for glm
+    mtx44Perpective(&m, fovy, aspect, near, far);
+    glm::mat4 proj = glm::perspective(fovy, 1.0f / aspect, near, far);
+    assert(m == proj);
+
+    mtx44Ortho(&m, -3.0f, 5.0f, -2.0f, 4.0f, near, far);
+    assert(m == glm::ortho(-3.0f, 5.0f, -2.0f, 4.0f, near, far));
+
+    mtx44 r, inv;
+    mtx44Perpective(&r, fovy, aspect, near, far);
+    mtx44Translate(&r, dist(gen), dist(gen), dist(gen));
+    mtx44Rotate(&r, (vec3f){ dist(gen), dist(gen), dist(gen) }, randomAngle(gen, dist));
+    mtx44Scale(&r, 1.0f + std::abs(dist(gen)), 1.0f + std::abs(dist(gen)), 1.0f + std::abs(dist(gen)));
+    assert(mtx44Inverse(&inv, &r));
+    {
+      glm::mat4 g = glm::inverse(loadMatrix(r));
+      for(size_t i = 0; i < 16; ++i)
+        assert(std::abs(inv.v[i] - g[i/4][i%4]) <= 0.001f * (1.0f + std::abs(g[i/4][i%4])));
+    }
+
+    mtx44 singular = {};
+    assert(!mtx44Inverse(&inv, &singular));
+
+    // check the camera's matrices
+    camera c;
+    cameraInit(&c);
+    assert(*cameraViewProjection(&c) == glm::mat4());
+
+    cameraLookAt(&c, (vec3f){ eye.x, eye.y, eye.z }, (vec3f){ target.x, target.y, target.z },
+                 (vec3f){ up.x, up.y, up.z });
+    cameraPerspective(&c, fovy, aspect, near, far);
+
+    assert(*cameraView(&c) == view);
+    assert(*cameraProjection(&c) == proj);
+
+    glm::mat4 vp = proj * view;
+    const mtx44 *cvp = cameraViewProjection(&c);
+    for(size_t i = 0; i < 16; ++i)
+      assert(std::abs(cvp->v[i] - vp[i/4][i%4]) <= 0.001f * (1.0f + std::abs(vp[i/4][i%4])));
+
+    // the inverse maps the near plane centre back to the view ray
+    glm::mat4 ivp = loadMatrix(*cameraInverseViewProjection(&c));
+    glm::vec4 p   = ivp * glm::vec4(0.0f, 0.0f, -1.0f, 1.0f);
+    glm::vec3 dir = glm::normalize(target - eye);
+    glm::vec3 e = eye + dir * near;
+    assert(std::abs(p.x / p.w - e.x) < 0.01f);
+    assert(std::abs(p.y / p.w - e.y) < 0.01f);
+    assert(std::abs(p.z / p.w - e.z) < 0.01f);
+
+    // points inside and outside the frustum
+    const vec4f *planes = cameraFrustum(&c);
+    glm::vec3 inside  = eye + dir * ((near + far) * 0.5f);
+    glm::vec3 behind  = eye - dir;
+    for(int i = 0; i < 6; ++i)
+    {
+      const vec4f &pl = planes[i];
+      assert(pl.x*inside.x + pl.y*inside.y + pl.z*inside.z + pl.w >= 0.0f);
+    }
+    assert(planes[4].x*behind.x + planes[4].y*behind.y + planes[4].z*behind.z + planes[4].w < 0.0f);
+
+    // unchanged inputs keep the cache; changed ones invalidate it
+    u32 clean = c.dirty;
+    cameraLookAt(&c, (vec3f){ eye.x, eye.y, eye.z }, (vec3f){ target.x, target.y, target.z },
+                 (vec3f){ up.x, up.y, up.z });
+    cameraPerspective(&c, fovy, aspect, near, far);
+    assert(c.dirty == clean && clean == 0);
+
+    cameraOrtho(&c, -3.0f, 5.0f, -2.0f, 4.0f, near, far);
+    assert(c.dirty != 0);
+    assert(*cameraProjection(&c) == glm::ortho(-3.0f, 5.0f, -2.0f, 4.0f, near, far));
+    assert(*cameraView(&c) == view);
+  }
+}
+
+static void
+check_quat_integrate(generator_t &gen, distribution_t &dist)
+{
+  const size_t count = 1000;
+
+  std::vector<float> r(count), i(count), j(count), k(count), drift(count);
+  std::vector<float> wx(count), wy(count), wz(count);
+  std::vector<quat>  expected(count);
+
+  quatSoA  q = { r.data(), i.data(), j.data(), k.data() };
+  vec3fSoA w = { wx.data(), wy.data(), wz.data() };
+
+  for(size_t n = 0; n < count; ++n)
+  {
+    quat tmp = quatNormalize(randomQuat(gen, dist));
+    glm::vec3 v = randomVector(gen, dist);
+
+    r[n] = tmp.r; i[n] = tmp.i; j[n] = tmp.j; k[n] = tmp.k;
+    wx[n] = v.x; wy[n] = v.y; wz[n] = v.z;
+    drift[n] = 0.0f;
+    expected[n] = tmp;
+  }
+  wx[0] = wy[0] = wz[0] = 0.0f;
+
+  // small steps take the series path, large ones the trig path
+  const float steps[] = { 0.01f, 0.2f };
+  for(float dt : steps)
+  {
+    for(size_t step = 0; step < 10; ++step)
+    {
+      quatIntegrateBatch(q, w, drift.data(), dt, 1.0e-3f, count);
+
+      for(size_t n = 0; n < count; ++n)
+      {
+        vec3f axis  = { wx[n], wy[n], wz[n] };
+        float angle = std::sqrt(vec3fDot(axis, axis)) * dt;
+
+        if(angle > 0.0f)
+          expected[n] = quatMultiply(quatRotate((quat){ 1.0f, 0.0f, 0.0f, 0.0f }, axis, angle),
+                                     expected[n]);
+
+        assert(std::abs(r[n] - expected[n].r) < 1.0e-4f);
+        assert(std::abs(i[n] - expected[n].i) < 1.0e-4f);
+        assert(std::abs(j[n] - expected[n].j) < 1.0e-4f);
+        assert(std::abs(k[n] - expected[n].k) < 1.0e-4f);
+        assert(drift[n] <= 1.0e-3f);
+      }
+    }
+  }
+
+  // the exponential map only renormalizes once rounding could matter
+  for(size_t n = 0; n < count; ++n)
+    drift[n] = 0.0f;
+  size_t renormalized = 0;
+  for(size_t step = 0; step < 100; ++step)
+    renormalized += quatIntegrateBatch(q, w, drift.data(), 0.01f, 1.0e-4f, count);
+  assert(renormalized < count);
+
+  // first order drifts outward; the drift bound must cover the real error
+  for(size_t n = 0; n < count; ++n)
+    drift[n] = 0.0f;
+  renormalized = 0;
+  for(size_t step = 0; step < 100; ++step)
+  {
+    renormalized += quatIntegrateLinearBatch(q, w, drift.data(), 0.01f, 1.0e-3f, count);
+
+    for(size_t n = 0; n < count; ++n)
+    {
+      float norm2 = r[n]*r[n] + i[n]*i[n] + j[n]*j[n] + k[n]*k[n];
+      assert(std::abs(norm2 - 1.0f) <= drift[n] + 1.0e-5f);
+      assert(std::abs(norm2 - 1.0f) <= 1.0e-3f + 1.0e-5f);
+    }
+  }
+  assert(renormalized > 0);
+}
+
+static bool
+nearlyEqual(const mtx44 &lhs, const mtx44 &rhs, float tolerance)
+{
+  for(size_t i = 0; i < 16; ++i)
+  {
+    if(std::abs(lhs.v[i] - rhs.v[i]) > tolerance * std::max(1.0f, std::abs(rhs.v[i])))
+      return false;
+  }
+
+  return true;
+}
+
+static void
+check_constexpr(generator_t &gen, distribution_t &dist)
+{
+  // these must be usable as constant expressions
+  static constexpr float halfPi = 1.57079632679489661923f;
+  static constexpr mtx44 ui     = gs::mtx44Ortho(0.0f, 400.0f, 0.0f, 240.0f, 0.0f, 1.0f);
+  static constexpr mtx44 quarter[] =
+  {
+    gs::mtx44RotateZ(gs::mtx44Identity(), 0.0f * halfPi),
+    gs::mtx44RotateZ(gs::mtx44Identity(), 1.0f * halfPi),
+    gs::mtx44RotateZ(gs::mtx44Identity(), 2.0f * halfPi),
+    gs::mtx44RotateZ(gs::mtx44Identity(), 3.0f * halfPi),
+  };
+  static constexpr quat  q    = gs::quatRotateY(gs::quatIdentity(), halfPi);
+  static constexpr mtx44 proj = gs::mtx44Perpective(halfPi, 240.0f / 400.0f, 0.1f, 100.0f);
+
+  static_assert(ui.v[0] == 2.0f / 400.0f && ui.v[12] == -1.0f, "ortho");
+  static_assert(quarter[1].v[1] == 1.0f && quarter[1].v[4] == -1.0f, "rotate z");
+  static_assert(quarter[1].v[0] < 1.0e-7f && quarter[1].v[0] > -1.0e-7f, "rotate z");
+  static_assert(quarter[2].v[0] == -1.0f && quarter[3].v[1] == -1.0f, "rotate z");
+  static_assert(q.r == q.j && q.i == 0.0f && q.k == 0.0f, "quat rotate");
+  static_assert(proj.v[5] > 0.99999f && proj.v[5] < 1.00001f, "perspective");
+  static_assert(gs::sqrt(2.0f) == 1.41421356237309504880f, "sqrt");
+  static_assert(gs::sqrt(0.0f) == 0.0f && gs::sqrt(1.0e-30f) > 0.0f, "sqrt");
+  static_assert(gs::sin(-3.0f * halfPi) == 1.0f && gs::cos(4.0f * halfPi) == 1.0f, "trig");
+
+  // compare against the runtime builders
+  for(size_t x = 0; x < 1000; ++x)
+  {
+    float angle = randomAngle(gen, dist) * 10.0f;
+
+    assert(std::abs(gs::sin(angle) - std::sin(angle)) < 1.0e-5f);
+    assert(std::abs(gs::cos(angle) - std::cos(angle)) < 1.0e-5f);
+
+    float v = std::abs(dist(gen)) * 1000.0f;
+    assert(std::abs(gs::sqrt(v) - std::sqrt(v)) <= 1.0e-6f * std::sqrt(v));
+
+    mtx44 base, m;
+    randomMatrix(base, gen, dist);
+    glm::vec3 axis  = randomVector(gen, dist);
+    vec3f     axisf = { axis.x, axis.y, axis.z };
+    glm::vec3 t     = randomVector(gen, dist);
+
+    m = base;
+    mtx44RotateX(&m, angle);
+    assert(nearlyEqual(gs::mtx44RotateX(base, angle), m, 1.0e-4f));
+
+    m = base;
+    mtx44RotateY(&m, angle);
+    assert(nearlyEqual(gs::mtx44RotateY(base, angle), m, 1.0e-4f));
+
+    m = base;
+    mtx44RotateZ(&m, angle);
+    assert(nearlyEqual(gs::mtx44RotateZ(base, angle), m, 1.0e-4f));
+
+    m = base;
+    mtx44Rotate(&m, axisf, angle);
+    assert(nearlyEqual(gs::mtx44Rotate(base, axisf, angle), m, 1.0e-4f));
+
+    m = base;
+    mtx44Translate(&m, t.x, t.y, t.z);
+    assert(nearlyEqual(gs::mtx44Translate(base, t.x, t.y, t.z), m, 1.0e-5f));
+
+    m = base;
+    mtx44Scale(&m, t.x, t.y, t.z);
+    assert(nearlyEqual(gs::mtx44Scale(base, t.x, t.y, t.z), m, 1.0e-5f));
+
+    mtx44 rhs;
+    randomMatrix(rhs, gen, dist);
+    mtx44Multiply(&m, &base, &rhs);
+    assert(nearlyEqual(gs::mtx44Multiply(base, rhs), m, 1.0e-5f));
+
+    glm::vec3 eye = randomVector(gen, dist);
+    mtx44LookAt(&m, (vec3f){ eye.x, eye.y, eye.z }, axisf, (vec3f){ t.x, t.y, t.z });
+    assert(nearlyEqual(gs::mtx44LookAt((vec3f){ eye.x, eye.y, eye.z }, axisf,
+                                       (vec3f){ t.x, t.y, t.z }), m, 1.0e-4f));
+
+    float fovy = 0.5f + std::abs(dist(gen)) * 0.1f;
+    mtx44Perpective(&m, fovy, 0.6f, 0.1f, 100.0f);
+    assert(nearlyEqual(gs::mtx44Perpective(fovy, 0.6f, 0.1f, 100.0f), m, 1.0e-5f));
+
+    mtx44Ortho(&m, -t.x - 1.0f, t.x + 1.0f, -1.0f, 1.0f, 0.1f, 10.0f);
+    assert(nearlyEqual(gs::mtx44Ortho(-t.x - 1.0f, t.x + 1.0f, -1.0f, 1.0f, 0.1f, 10.0f), m, 1.0e-6f));
+
+    quat q1 = quatNormalize(randomQuat(gen, dist));
+    quat q2 = randomQuat(gen, dist);
+    assert(loadQuat(quatMultiply(q1, q2)) == gs::quatMultiply(q1, q2));
+    assert(loadQuat(quatNormalize(q2)) == gs::quatNormalize(q2));
+    assert(loadQuat(quatRotate(q1, axisf, angle)) == gs::quatRotate(q1, axisf, angle));
+    assert(loadQuat(quatRotateX(q1, angle)) == gs::quatRotateX(q1, angle));
+    assert(loadQuat(quatRotateY(q1, angle)) == gs::quatRotateY(q1, angle));
+    assert(loadQuat(quatRotateZ(q1, angle)) == gs::quatRotateZ(q1, angle));
+
+    quatToMtx44(&m, q1);
+    assert(nearlyEqual(gs::quatToMtx44(q1), m, 1.0e-6f));
+  }
+}
+
+static void
+check_math_file(generator_t &gen, distribution_t &dist)
+{
+  std::vector<mtx44> matrices(100);
+  std::vector<quat>  rotations(37);
+  std::vector<vec3f> positions(1001);
+  const char         name[] = "clip";
+
+  for(auto &m : matrices)
+    randomMatrix(m, gen, dist);
+  for(auto &q : rotations)
+    q = randomQuat(gen, dist);
+  for(auto &v : positions)
+  {
+    glm::vec3 tmp = randomVector(gen, dist);
+    v = (vec3f){ tmp.x, tmp.y, tmp.z };
+  }
+
+  const mathFileSource sources[] =
+  {
+    { MATH_FILE_BYTES, 0, name,             sizeof(name)     },
+    { MATH_FILE_VEC3F, 1, positions.data(), positions.size() },
+    { MATH_FILE_QUAT,  1, rotations.data(), rotations.size() },
+    { MATH_FILE_MTX44, 7, matrices.data(),  matrices.size()  },
+    { MATH_FILE_FLOAT, 2, NULL,             0                },
+  };
+
+  char path[] = "/tmp/gs_math_XXXXXX";
+  int  fd     = mkstemp(path);
+  assert(fd >= 0);
+  close(fd);
+
+  assert(mathFileWrite(path, sources, sizeof(sources)/sizeof(sources[0])));
+
+  mathFile f;
+  assert(mathFileOpen(&f, path));
+  assert(f.header->sectionCount == 5);
+  assert(mathFileVerify(&f));
+
+  size_t count;
+  const mtx44 *m = mathFileMtx44(&f, 7, &count);
+  assert(m && count == matrices.size());
+  assert(((uintptr_t)m % MATH_FILE_ALIGN) == 0);
+  assert(std::memcmp(m, matrices.data(), count * sizeof(mtx44)) == 0);
+
+  const quat *q = mathFileQuat(&f, 1, &count);
+  assert(q && count == rotations.size());
+  assert(std::memcmp(q, rotations.data(), count * sizeof(quat)) == 0);
+
+  const vec3f *v = mathFileVec3f(&f, 1, &count);
+  assert(v && count == positions.size());
+  assert(std::memcmp(v, positions.data(), count * sizeof(vec3f)) == 0);
+
+  assert(std::strcmp((const char*)mathFileFind(&f, MATH_FILE_BYTES, 0, NULL), name) == 0);
+  assert(mathFileFind(&f, MATH_FILE_FLOAT, 2, &count) && count == 0);
+  assert(!mathFileMtx44(&f, 1, &count) && count == 0);
+
+  // validate an in-memory copy, then damage it
+  size_t size = f.size;
+  void  *copy = NULL;
+  assert(posix_memalign(&copy, MATH_FILE_ALIGN, size) == 0);
+  std::memcpy(copy, f.base, size);
+  mathFileClose(&f);
+  assert(!f.base);
+  unlink(path);
+
+  mathFile g;
+  assert(mathFileLoad(&g, copy, size));
+  assert(mathFileMtx44(&g, 7, NULL) == (const mtx44*)((char*)copy + g.sections[3].offset));
+
+  ((char*)copy)[g.sections[3].offset + 5] ^= 1;
+  assert(!mathFileVerify(&g));
+  ((char*)copy)[g.sections[3].offset + 5] ^= 1;
+  assert(mathFileVerify(&g));
+
+  assert(!mathFileLoad(&g, copy, size - 1));
+  assert(!mathFileLoad(&g, (char*)copy + 16, size - 16));
+
+  mathFileSection *sections = (mathFileSection*)((char*)copy + sizeof(mathFileHeader));
+  sections[2].count += 1000000;
+  assert(!mathFileLoad(&g, copy, size));
+  sections[2].count -= 1000000;
+  sections[2].offset += 4;
+  assert(!mathFileLoad(&g, copy, size));
+  sections[2].offset -= 4;
+  sections[2].type = 99;
+  assert(!mathFileLoad(&g, copy, size));
+  sections[2].type = MATH_FILE_QUAT;
+
+  mathFileHeader *header = (mathFileHeader*)copy;
+  header->version = MATH_FILE_VERSION + 1;
+  assert(!mathFileLoad(&g, copy, size));
+  header->version = MATH_FILE_VERSION;
+  header->sectionCount = 0x10000000;
+  assert(!mathFileLoad(&g, copy, size));
+  header->sectionCount = 5;
+  assert(mathFileLoad(&g, copy, size));
+
+  free(copy);
+
+  // unknown types are rejected by the writer, missing files by the reader
+  const mathFileSource bad = { 99, 0, name, 1 };
+  assert(!mathFileWrite(path, &bad, 1));
+  assert(!mathFileOpen(&f, path));
+}
+
+static bool
+nearlyEqual(const vec3f &lhs, const vec3f &rhs, float tolerance)
+{
+  return std::abs(lhs.x - rhs.x) <= tolerance
+      && std::abs(lhs.y - rhs.y) <= tolerance
+      && std::abs(lhs.z - rhs.z) <= tolerance;
+}
+
+static inline bool
+nearlyEqual(const quat &lhs, const quat &rhs, float tolerance)
+{
+  return std::abs(lhs.r - rhs.r) <= tolerance * std::max(1.0f, std::abs(rhs.r))
+      && std::abs(lhs.i - rhs.i) <= tolerance * std::max(1.0f, std::abs(rhs.i))
+      && std::abs(lhs.j - rhs.j) <= tolerance * std::max(1.0f, std::abs(rhs.j))
+      && std::abs(lhs.k - rhs.k) <= tolerance * std::max(1.0f, std::abs(rhs.k));
+}
+
+static void
+check_splines(generator_t &gen, distribution_t &dist)
+{
+  const size_t count = 100;
+
+  std::vector<vec3f> points(count + 3);
+  for(auto &p : points)
+  {
+    glm::vec3 v = randomVector(gen, dist);
+    p = (vec3f){ v.x, v.y, v.z };
+  }
+
+  std::vector<cubic> curves(count);
+  cubicFromCatmullRomBatch(curves.data(), points.data(), points.size());
+
+  std::vector<float> t(count);
+  for(auto &x : t)
+    x = std::abs(dist(gen)) / 10.0f;
+
+  for(size_t n = 0; n < count; ++n)
+  {
+    const vec3f *p = &points[n];
+    const cubic &c = curves[n];
+
+    // Catmull-Rom interpolates p1..p2 with tangents (p[i+1] - p[i-1]) / 2
+    assert(nearlyEqual(cubicEvaluate(&c, 0.0f), p[1], 1.0e-4f));
+    assert(nearlyEqual(cubicEvaluate(&c, 1.0f), p[2], 1.0e-4f));
+    assert(nearlyEqual(cubicTangent(&c, 0.0f), vec3fScale(vec3fSubtract(p[2], p[0]), 0.5f), 1.0e-4f));
+    assert(nearlyEqual(cubicTangent(&c, 1.0f), vec3fScale(vec3fSubtract(p[3], p[1]), 0.5f), 1.0e-4f));
+
+    // Bezier against the Bernstein form
+    cubic b = cubicFromBezier(p[0], p[1], p[2], p[3]);
+    float s = t[n], u = 1.0f - s;
+    vec3f expected = vec3fAdd(vec3fAdd(vec3fScale(p[0], u*u*u), vec3fScale(p[1], 3.0f*u*u*s)),
+                              vec3fAdd(vec3fScale(p[2], 3.0f*u*s*s), vec3fScale(p[3], s*s*s)));
+    assert(nearlyEqual(cubicEvaluate(&b, s), expected, 1.0e-3f));
+
+    // Hermite end points and tangents
+    cubic h = cubicFromHermite(p[0], p[1], p[2], p[3]);
+    assert(nearlyEqual(cubicEvaluate(&h, 0.0f), p[0], 1.0e-4f));
+    assert(nearlyEqual(cubicEvaluate(&h, 1.0f), p[2], 1.0e-4f));
+    assert(nearlyEqual(cubicTangent(&h, 0.0f), p[1], 1.0e-4f));
+    assert(nearlyEqual(cubicTangent(&h, 1.0f), p[3], 1.0e-4f));
+  }
+
+  std::vector<vec3f> out(count);
+  cubicEvaluateBatch(out.data(), &curves[0], t.data(), count);
+  for(size_t n = 0; n < count; ++n)
+    assert(nearlyEqual(out[n], cubicEvaluate(&curves[0], t[n]), 1.0e-5f));
+
+  cubicEvaluateCurvesBatch(out.data(), curves.data(), t.data(), count);
+  for(size_t n = 0; n < count; ++n)
+    assert(nearlyEqual(out[n], cubicEvaluate(&curves[n], t[n]), 1.0e-5f));
+
+  // forward differencing tracks direct evaluation; segments join up to
+  // rounding
+  const size_t steps = 64;
+  std::vector<vec3f> samples(count * (steps + 1));
+  cubicTessellateBatch(samples.data(), curves.data(), count, steps);
+  for(size_t n = 0; n < count; ++n)
+  {
+    for(size_t i = 0; i <= steps; ++i)
+      assert(nearlyEqual(samples[n*(steps+1) + i], cubicEvaluate(&curves[n], (float)i / steps), 1.0e-3f));
+
+    if(n > 0)
+      assert(nearlyEqual(samples[n*(steps+1)], samples[n*(steps+1) - 1], 1.0e-4f));
+  }
+}
+
+static double
+angleBetween(const vec3f &a, const vec3f &b)
+{
+  double cx = (double)a.y*b.z - (double)a.z*b.y;
+  double cy = (double)a.z*b.x - (double)a.x*b.z;
+  double cz = (double)a.x*b.y - (double)a.y*b.x;
+  double d  = (double)a.x*b.x + (double)a.y*b.y + (double)a.z*b.z;
+
+  return std::atan2(std::sqrt(cx*cx + cy*cy + cz*cz), d) * 180.0 / M_PI;
+}
+
+static void
+check_octahedral(generator_t &gen, distribution_t &dist)
+{
+  std::vector<vec3f> normals;
+
+  // axes and octant diagonals sit on the folds of the encoding
+  for(int i = 0; i < 3; ++i)
+  {
+    for(float s : { 1.0f, -1.0f })
+    {
+      vec3f v = { 0.0f, 0.0f, 0.0f };
+      (&v.x)[i] = s;
+      normals.push_back(v);
+    }
+  }
+
+  for(int i = 0; i < 8; ++i)
+    normals.push_back(vec3fNormalize((vec3f){ i & 1 ? -1.0f : 1.0f, i & 2 ? -1.0f : 1.0f, i & 4 ? -1.0f : 1.0f }));
+
+  for(size_t i = 0; i < 10000; ++i)
+  {
+    glm::vec3 v = randomVector(gen, dist);
+    if(glm::length(v) > 1.0e-3f)
+      normals.push_back(vec3fNormalize((vec3f){ v.x, v.y, v.z }));
+  }
+
+  for(size_t i = 0; i < 6; ++i)
+  {
+    assert(nearlyEqual(oct16ToVec3f(vec3fToOct16(normals[i])), normals[i], 1.0e-6f));
+    assert(nearlyEqual(oct32ToVec3f(vec3fToOct32(normals[i])), normals[i], 1.0e-6f));
+  }
+
+  for(const auto &n : normals)
+  {
+    vec3f a = oct16ToVec3f(vec3fToOct16(n));
+    vec3f b = oct32ToVec3f(vec3fToOct32(n));
+
+    assert(std::abs(vec3fDot(a, a) - 1.0f) < 1.0e-5f);
+    assert(std::abs(vec3fDot(b, b) - 1.0f) < 1.0e-5f);
+    assert(angleBetween(a, n) < 1.0);
+    assert(angleBetween(b, n) < 0.004);
+  }
+
+  const size_t count = normals.size();
+
+  std::vector<u16>   codes16(count);
+  std::vector<u32>   codes32(count);
+  std::vector<vec3f> out(count);
+
+  vec3fToOct16Batch(codes16.data(), normals.data(), count);
+  oct16ToVec3fBatch(out.data(), codes16.data(), count);
+  for(size_t i = 0; i < count; ++i)
+  {
+    assert(codes16[i] == vec3fToOct16(normals[i]));
+    assert(nearlyEqual(out[i], oct16ToVec3f(codes16[i]), 0.0f));
+  }
+
+  vec3fToOct32Batch(codes32.data(), normals.data(), count);
+  oct32ToVec3fBatch(out.data(), codes32.data(), count);
+  for(size_t i = 0; i < count; ++i)
+  {
+    assert(codes32[i] == vec3fToOct32(normals[i]));
+    assert(nearlyEqual(out[i], oct32ToVec3f(codes32[i]), 0.0f));
+  }
+}
+
+static void
+check_rotation_cache(generator_t &gen, distribution_t &dist)
+{
+  const u32 steps = 256;
+
+  rotationCache c;
+  assert(rotationCacheInit(&c, steps));
+
+  // quantization rounds to the nearest step and wraps
+  for(u32 step = 0; step < steps; ++step)
+  {
+    float r = step * (float)(2.0 * M_PI) / steps;
+    assert(rotationCacheStep(&c, r) == step);
+    assert(rotationCacheStep(&c, r - (float)(2.0 * M_PI)) == step);
+  }
+
+  std::vector<vec3f> axes(2 * ROTATION_CACHE_AXES);
+  for(auto &a : axes)
+  {
+    glm::vec3 v = randomVector(gen, dist);
+    a = (vec3f){ v.x, v.y, v.z };
+  }
+
+  for(size_t i = 0; i < 1000; ++i)
+  {
+    u32   step = (u32)(std::abs(dist(gen)) * 1000.0f);
+    float r    = (step % steps) * (float)(2.0 * M_PI) / steps;
+
+    mtx44 base, expected, actual;
+    randomMatrix(base, gen, dist);
+
+    expected = actual = base;
+    mtx44RotateX(&expected, r);
+    mtx44RotateXCached(&actual, &c, step);
+    assert(nearlyEqual(actual, expected, 1.0e-4f));
+
+    expected = actual = base;
+    mtx44RotateY(&expected, r);
+    mtx44RotateYCached(&actual, &c, step);
+    assert(nearlyEqual(actual, expected, 1.0e-4f));
+
+    expected = actual = base;
+    mtx44RotateZ(&expected, r);
+    mtx44RotateZCached(&actual, &c, step);
+    assert(nearlyEqual(actual, expected, 1.0e-4f));
+
+    // cycle through more axes than the cache holds to exercise eviction
+    vec3f axis = axes[i % axes.size()];
+    expected = actual = base;
+    mtx44Rotate(&expected, axis, r);
+    mtx44RotateCached(&actual, &c, axis, step);
+    assert(nearlyEqual(actual, expected, 1.0e-4f));
+
+    quat q = randomQuat(gen, dist);
+    assert(nearlyEqual(quatRotateXCached(&c, q, step), quatRotateX(q, r), 1.0e-4f));
+    assert(nearlyEqual(quatRotateYCached(&c, q, step), quatRotateY(q, r), 1.0e-4f));
+    assert(nearlyEqual(quatRotateZCached(&c, q, step), quatRotateZ(q, r), 1.0e-4f));
+  }
+
+  // repeated lookups hit the same block
+  const float *block = rotationCacheLookup(&c, axes[0], 3);
+  assert(rotationCacheLookup(&c, axes[0], 3 + steps) == block);
+
+  rotationCacheFree(&c);
+  assert(c.table == NULL);
+}
+
+static boneTransform
+randomBoneTransform(generator_t &gen, distribution_t &dist)
+{
+  boneTransform b;
+
+  b.rotation    = quatNormalize(randomQuat(gen, dist));
+  b.translation = (vec3f){ dist(gen), dist(gen), dist(gen) };
+  b.scale       = (vec3f){ 0.5f + std::abs(dist(gen)) / 10.0f,
+                           0.5f + std::abs(dist(gen)) / 10.0f,
+                           0.5f + std::abs(dist(gen)) / 10.0f };
+
+  return b;
+}
+
+static mtx44
+referenceBone(const boneTransform &b)
+{
+  mtx44 m, r, tmp;
+
+  mtx44Identity(&m);
+  mtx44Translate(&m, b.translation.x, b.translation.y, b.translation.z);
+  quatToMtx44(&r, b.rotation);
+  mtx44Multiply(&tmp, &m, &r);
+  mtx44Scale(&tmp, b.scale.x, b.scale.y, b.scale.z);
+
+  return tmp;
+}
+
+static void
+check_skeleton(generator_t &gen, distribution_t &dist)
+{
+  const size_t bones = 40, instances = 8;
+
+  std::vector<s32>   parents(bones);
+  std::vector<mtx44> inverseBind(bones);
+
+  for(size_t i = 0; i < bones; ++i)
+  {
+    parents[i] = i == 0 ? -1 : (s32)(std::abs(dist(gen)) / 10.0f * i) - (i % 7 == 0);
+    if(parents[i] >= (s32)i)
+      parents[i] = (s32)i - 1;
+
+    mtx44 bind = referenceBone(randomBoneTransform(gen, dist));
+    assert(mtx44Inverse(&inverseBind[i], &bind));
+  }
+
+  skeleton s;
+
+  // children must come after their parents
+  std::vector<s32> cyclic = { -1, 2, 0 };
+  assert(!skeletonInit(&s, cyclic.data(), inverseBind.data(), cyclic.size()));
+  assert(!skeletonInit(&s, nullptr, inverseBind.data(), bones));
+  assert(!skeletonInit(&s, parents.data(), nullptr, bones));
+
+  assert(skeletonInit(&s, parents.data(), inverseBind.data(), bones));
+
+  std::vector<boneTransform> pose(bones * instances);
+  for(auto &b : pose)
+    b = randomBoneTransform(gen, dist);
+
+  std::vector<mtx44> world(bones * instances), palette(bones * instances);
+  skeletonPaletteBatch(&s, pose.data(), world.data(), palette.data(), instances);
+
+  for(size_t n = 0; n < instances; ++n)
+  {
+    std::vector<mtx44> expected(bones);
+
+    for(size_t i = 0; i < bones; ++i)
+    {
+      mtx44 local = referenceBone(pose[n*bones + i]);
+
+      if(parents[i] < 0)
+        expected[i] = local;
+      else
+        mtx44Multiply(&expected[i], &expected[parents[i]], &local);
+
+      mtx44 skin;
+      mtx44Multiply(&skin, &expected[i], &inverseBind[i]);
+
+      assert(nearlyEqual(world[n*bones + i], expected[i], 1.0e-3f));
+      assert(nearlyEqual(palette[n*bones + i], skin, 1.0e-3f));
+    }
+  }
+
+  std::vector<mtx44> world2(bones * instances), palette2(bones * instances);
+  threadPool *pool = threadPoolCreate(4);
+  skeletonPaletteBatchParallel(pool, &s, pose.data(), world2.data(), palette2.data(), instances);
+  threadPoolDestroy(pool);
+  assert(std::memcmp(world.data(), world2.data(), world.size() * sizeof(mtx44)) == 0);
+  assert(std::memcmp(palette.data(), palette2.data(), palette.size() * sizeof(mtx44)) == 0);
+
+  std::vector<vec4f> rows(bones * 3);
+  skeletonPaletteAffine(&s, pose.data(), world2.data(), rows.data());
+  for(size_t i = 0; i < bones; ++i)
+  {
+    for(size_t j = 0; j < 3; ++j)
+    {
+      const mtx44 &m = palette[i];
+      assert(rows[i*3 + j].x == m.v[0*4+j] && rows[i*3 + j].y == m.v[1*4+j]
+          && rows[i*3 + j].z == m.v[2*4+j] && rows[i*3 + j].w == m.v[3*4+j]);
+    }
+  }
+
+  skeletonFree(&s);
+}
+
+static void
+check_particles(generator_t &gen, distribution_t &dist)
+{
+  const size_t count = 1003; // not a multiple of the vector width
+
+  vec3fSoA p, v, a;
+  assert(vec3fSoAInit(&p, count));
+  assert(vec3fSoAInit(&v, count));
+  assert(vec3fSoAInit(&a, count));
+  assert(((uintptr_t)p.x | (uintptr_t)p.y | (uintptr_t)p.z) % 64 == 0);
+
+  std::vector<vec3f> pa(count), va(count), aa(count);
+  std::vector<u8>    alive(count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    pa[n] = (vec3f){ dist(gen), dist(gen), dist(gen) };
+    va[n] = (vec3f){ dist(gen), dist(gen), dist(gen) };
+    aa[n] = (vec3f){ dist(gen), dist(gen), dist(gen) };
+    alive[n] = dist(gen) > -5.0f;
+
+    p.x[n] = pa[n].x; p.y[n] = pa[n].y; p.z[n] = pa[n].z;
+    v.x[n] = va[n].x; v.y[n] = va[n].y; v.z[n] = va[n].z;
+    a.x[n] = aa[n].x; a.y[n] = aa[n].y; a.z[n] = aa[n].z;
+  }
+
+  auto load = [](const vec3fSoA &s, size_t n) { return (vec3f){ s.x[n], s.y[n], s.z[n] }; };
+
+  const vec3f gravity = { 0.0f, -9.8f, 0.0f };
+  const float dt = 1.0f / 60.0f, damping = 0.99f;
+
+  vec3fSoAIntegrate(p, v, gravity, damping, dt, alive.data(), count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    if(alive[n])
+    {
+      va[n] = vec3fAdd(vec3fScale(va[n], damping), vec3fScale(gravity, dt));
+      pa[n] = vec3fAdd(pa[n], vec3fScale(va[n], dt));
+    }
+
+    assert(nearlyEqual(load(v, n), va[n], 1.0e-5f));
+    assert(nearlyEqual(load(p, n), pa[n], 1.0e-5f));
+  }
+
+  vec3fSoAAxpy(v, dt, a, count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    va[n] = vec3fAdd(va[n], vec3fScale(aa[n], dt));
+    assert(nearlyEqual(load(v, n), va[n], 1.0e-5f));
+  }
+
+  vec3fSoAAxpby(v, 0.5f, a, 0.25f, count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    va[n] = vec3fAdd(vec3fScale(aa[n], 0.5f), vec3fScale(va[n], 0.25f));
+    assert(nearlyEqual(load(v, n), va[n], 1.0e-5f));
+  }
+
+  vec3fSoAFma(p, a, v, p, count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    pa[n] = (vec3f){ aa[n].x*va[n].x + pa[n].x, aa[n].y*va[n].y + pa[n].y, aa[n].z*va[n].z + pa[n].z };
+    assert(nearlyEqual(load(p, n), pa[n], 1.0e-4f));
+  }
+
+  std::vector<float> out(count);
+  vec3fSoADot(out.data(), a, v, count);
+  for(size_t n = 0; n < count; ++n)
+    assert(std::abs(out[n] - vec3fDot(aa[n], va[n])) <= 1.0e-4f * std::max(1.0f, std::abs(out[n])));
+
+  vec3fSoALength(out.data(), a, count);
+  for(size_t n = 0; n < count; ++n)
+    assert(std::abs(out[n] - std::sqrt(vec3fDot(aa[n], aa[n]))) < 1.0e-4f);
+
+  a.x[7] = a.y[7] = a.z[7] = 0.0f;
+  vec3fSoANormalize(a, count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    vec3f u = load(a, n);
+    if(n == 7)
+      assert(u.x == 0.0f && u.y == 0.0f && u.z == 0.0f);
+    else
+      assert(nearlyEqual(u, vec3fNormalize(aa[n]), 1.0e-5f));
+  }
+
+  const vec3f lo = { -1.0f, -2.0f, -3.0f }, hi = { 1.0f, 2.0f, 3.0f };
+  vec3fSoAClamp(p, lo, hi, count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    vec3f c = { std::min(std::max(pa[n].x, lo.x), hi.x),
+                std::min(std::max(pa[n].y, lo.y), hi.y),
+                std::min(std::max(pa[n].z, lo.z), hi.z) };
+    assert(nearlyEqual(load(p, n), c, 0.0f));
+    pa[n] = c;
+  }
+
+  size_t kept = vec3fSoACompact(p, alive.data(), count);
+  assert(kept == (size_t)std::count(alive.begin(), alive.end(), 1));
+  for(size_t n = 0, k = 0; n < count; ++n)
+  {
+    if(alive[n])
+      assert(nearlyEqual(load(p, k++), pa[n], 0.0f));
+  }
+
+  vec3fSoAFree(&p);
+  vec3fSoAFree(&v);
+  vec3fSoAFree(&a);
+}
+
+struct contactBuffers
+{
+  std::vector<float> nx, ny, nz, px, py, pz, depth;
+
+  explicit contactBuffers(size_t count)
+  : nx(count), ny(count), nz(count), px(count), py(count), pz(count), depth(count)
+  {
+  }
+
+  contactSoA soa()
+  {
+    return (contactSoA){ { nx.data(), ny.data(), nz.data() }, { px.data(), py.data(), pz.data() }, depth.data() };
+  }
+
+  vec3f normal(size_t n) const { return (vec3f){ nx[n], ny[n], nz[n] }; }
+  vec3f point(size_t n) const { return (vec3f){ px[n], py[n], pz[n] }; }
+};
+
+struct vec3fBuffers
+{
+  std::vector<float> x, y, z;
+
+  explicit vec3fBuffers(const std::vector<vec3f> &v)
+  {
+    for(const auto &e : v)
+    {
+      x.push_back(e.x);
+      y.push_back(e.y);
+      z.push_back(e.z);
+    }
+  }
+
+  vec3fSoA soa() { return (vec3fSoA){ x.data(), y.data(), z.data() }; }
+};
+
+// Ericson's closest points between segments, branches and all
+static void
+closestSegmentPoints(vec3f p1, vec3f q1, vec3f p2, vec3f q2, vec3f &c1, vec3f &c2)
+{
+  vec3f d1 = vec3fSubtract(q1, p1), d2 = vec3fSubtract(q2, p2), r = vec3fSubtract(p1, p2);
+  float a = vec3fDot(d1, d1), e = vec3fDot(d2, d2), f = vec3fDot(d2, r);
+  float s, t;
+
+  auto clamp = [](float x) { return std::min(std::max(x, 0.0f), 1.0f); };
+
+  if(a == 0.0f && e == 0.0f)
+    s = t = 0.0f;
+  else if(a == 0.0f)
+  {
+    s = 0.0f;
+    t = clamp(f / e);
+  }
+  else
+  {
+    float c = vec3fDot(d1, r);
+    if(e == 0.0f)
+    {
+      t = 0.0f;
+      s = clamp(-c / a);
+    }
+    else
+    {
+      float b = vec3fDot(d1, d2), denom = a*e - b*b;
+
+      s = denom > 0.0f ? clamp((b*f - c*e) / denom) : clamp(-c / a);
+      t = (b*s + f) / e;
+
+      if(t < 0.0f)
+      {
+        t = 0.0f;
+        s = clamp(-c / a);
+      }
+      else if(t > 1.0f)
+      {
+        t = 1.0f;
+        s = clamp((b - c) / a);
+      }
+    }
+  }
+
+  c1 = vec3fAdd(p1, vec3fScale(d1, s));
+  c2 = vec3fAdd(p2, vec3fScale(d2, t));
+}
+
+static void
+check_contacts(generator_t &gen, distribution_t &dist)
+{
+  const size_t count = 37; // not a multiple of the vector width
+
+  auto point = [&]() { return (vec3f){ dist(gen) / 2.0f, dist(gen) / 2.0f, dist(gen) / 2.0f }; };
+  auto radius = [&]() { return 0.5f + std::abs(dist(gen)) / 4.0f; };
+
+  std::vector<vec3f> c0(count), c1(count), c2(count), c3(count);
+  std::vector<float> r0(count), r1(count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    c0[n] = point();
+    c1[n] = point();
+    c2[n] = point();
+    c3[n] = point();
+    r0[n] = radius();
+    r1[n] = radius();
+  }
+
+  // a degenerate capsule (a sphere) and coincident spheres
+  c1[3] = c0[3];
+  c2[5] = c0[5];
+
+  vec3fBuffers b0(c0), b1(c1), b2(c2), b3(c3);
+  contactBuffers out(count);
+
+  // sphere-sphere
+  sphereSoA sa = { b0.soa(), r0.data() }, sb = { b2.soa(), r1.data() };
+  size_t touching = sphereSphereContactBatch(out.soa(), sa, sb, count), expected = 0;
+  for(size_t n = 0; n < count; ++n)
+  {
+    vec3f d = vec3fSubtract(c2[n], c0[n]);
+    float l = std::sqrt(vec3fDot(d, d));
+    vec3f normal = l > 0.0f ? vec3fScale(d, 1.0f / l) : (vec3f){ 0.0f, 1.0f, 0.0f };
+    float depth = r0[n] + r1[n] - l;
+
+    assert(std::abs(out.depth[n] - depth) < 1.0e-4f);
+    assert(nearlyEqual(out.normal(n), normal, 1.0e-4f));
+    assert(nearlyEqual(out.point(n), vec3fAdd(c0[n], vec3fScale(normal, r0[n] - depth/2)), 1.0e-4f));
+    expected += depth >= 0.0f;
+  }
+  assert(touching == expected);
+
+  // capsule-capsule
+  capsuleSoA ca = { b0.soa(), b1.soa(), r0.data() }, cb = { b2.soa(), b3.soa(), r1.data() };
+  touching = capsuleCapsuleContactBatch(out.soa(), ca, cb, count);
+  expected = 0;
+  for(size_t n = 0; n < count; ++n)
+  {
+    vec3f p, q;
+    closestSegmentPoints(c0[n], c1[n], c2[n], c3[n], p, q);
+
+    vec3f d = vec3fSubtract(q, p);
+    float depth = r0[n] + r1[n] - std::sqrt(vec3fDot(d, d));
+
+    assert(std::abs(out.depth[n] - depth) < 1.0e-3f);
+    assert(std::abs(vec3fDot(out.normal(n), out.normal(n)) - 1.0f) < 1.0e-4f);
+    expected += depth >= 0.0f;
+  }
+  assert(touching == expected);
+
+  // crossing axes touch at the crossing; parallel axes use their gap
+  {
+    std::vector<vec3f> pa = { { -1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+    std::vector<vec3f> qa = { {  1.0f, 0.0f, 0.0f }, { 0.0f, 4.0f, 0.0f } };
+    std::vector<vec3f> pb = { { 0.0f, -1.0f, 1.0f }, { 1.0f, 1.0f, 0.0f } };
+    std::vector<vec3f> qb = { { 0.0f,  1.0f, 1.0f }, { 1.0f, 3.0f, 0.0f } };
+    std::vector<float> rr = { 0.75f, 0.75f };
+
+    vec3fBuffers bpa(pa), bqa(qa), bpb(pb), bqb(qb);
+    contactBuffers o(2);
+    capsuleSoA x = { bpa.soa(), bqa.soa(), rr.data() }, y = { bpb.soa(), bqb.soa(), rr.data() };
+
+    assert(capsuleCapsuleContactBatch(o.soa(), x, y, 2) == 2);
+    assert(std::abs(o.depth[0] - 0.5f) < 1.0e-6f);
+    assert(nearlyEqual(o.normal(0), (vec3f){ 0.0f, 0.0f, 1.0f }, 1.0e-6f));
+    assert(nearlyEqual(o.point(0), (vec3f){ 0.0f, 0.0f, 0.5f }, 1.0e-6f));
+    assert(std::abs(o.depth[1] - 0.5f) < 1.0e-6f);
+    assert(nearlyEqual(o.normal(1), (vec3f){ 1.0f, 0.0f, 0.0f }, 1.0e-6f));
+  }
+
+  // boxes spanning each pair of corners
+  std::vector<vec3f> min0(count), max0(count), min1(count), max1(count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    min0[n] = (vec3f){ std::min(c0[n].x, c1[n].x), std::min(c0[n].y, c1[n].y), std::min(c0[n].z, c1[n].z) };
+    max0[n] = (vec3f){ std::max(c0[n].x, c1[n].x), std::max(c0[n].y, c1[n].y), std::max(c0[n].z, c1[n].z) };
+    min1[n] = (vec3f){ std::min(c2[n].x, c3[n].x), std::min(c2[n].y, c3[n].y), std::min(c2[n].z, c3[n].z) };
+    max1[n] = (vec3f){ std::max(c2[n].x, c3[n].x), std::max(c2[n].y, c3[n].y), std::max(c2[n].z, c3[n].z) };
+  }
+
+  vec3fBuffers bmin0(min0), bmax0(max0), bmin1(min1), bmax1(max1);
+  aabbSoA ba = { bmin0.soa(), bmax0.soa() }, bb = { bmin1.soa(), bmax1.soa() };
+
+  // sphere-box: depth is the radius minus the distance to the box, or plus
+  // the distance to the nearest face from inside
+  touching = sphereAabbContactBatch(out.soa(), sb, ba, count);
+  expected = 0;
+  for(size_t n = 0; n < count; ++n)
+  {
+    vec3f c = c2[n], lo = min0[n], hi = max0[n];
+    vec3f q = { std::min(std::max(c.x, lo.x), hi.x), std::min(std::max(c.y, lo.y), hi.y), std::min(std::max(c.z, lo.z), hi.z) };
+    vec3f d = vec3fSubtract(q, c);
+    float l = std::sqrt(vec3fDot(d, d)), depth;
+
+    if(l > 0.0f)
+    {
+      depth = r1[n] - l;
+      assert(nearlyEqual(out.normal(n), vec3fScale(d, 1.0f / l), 1.0e-4f));
+    }
+    else
+    {
+      float face = std::min({ c.x - lo.x, hi.x - c.x, c.y - lo.y, hi.y - c.y, c.z - lo.z, hi.z - c.z });
+      depth = r1[n] + face;
+    }
+
+    assert(std::abs(out.depth[n] - depth) < 1.0e-4f);
+    expected += depth >= 0.0f;
+  }
+  assert(touching == expected);
+
+  // box-box
+  touching = aabbAabbContactBatch(out.soa(), ba, bb, count);
+  expected = 0;
+  for(size_t n = 0; n < count; ++n)
+  {
+    float ox = std::min(max0[n].x, max1[n].x) - std::max(min0[n].x, min1[n].x);
+    float oy = std::min(max0[n].y, max1[n].y) - std::max(min0[n].y, min1[n].y);
+    float oz = std::min(max0[n].z, max1[n].z) - std::max(min0[n].z, min1[n].z);
+    float depth = std::min({ ox, oy, oz });
+
+    assert(out.depth[n] == depth);
+    assert(std::abs(vec3fDot(out.normal(n), out.normal(n)) - 1.0f) < 1.0e-6f);
+    expected += depth >= 0.0f;
+  }
+  assert(touching == expected);
+}
+
+static void
+check_orthonormalize(generator_t &gen, distribution_t &dist)
+{
+  const size_t count = 64;
+
+  std::vector<mtx44> m(count), rotations(count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    quatToMtx44(&rotations[n], quatNormalize(randomQuat(gen, dist)));
+    rotations[n].v[12] = dist(gen);
+    rotations[n].v[13] = dist(gen);
+    rotations[n].v[14] = dist(gen);
+    m[n] = rotations[n];
+  }
+
+  // a scaled rotation comes back as the rotation
+  mtx44 scaled = rotations[0];
+  mtx44Scale(&scaled, 2.0f, 2.0f, 2.0f);
+  mtx44Orthonormalize(&scaled);
+  assert(nearlyEqual(scaled, rotations[0], 1.0e-5f));
+
+  // scale and skew together still give a rotation
+  mtx44 skewed = rotations[1];
+  mtx44Scale(&skewed, 3.0f, 3.0f, 3.0f);
+  for(size_t j = 0; j < 3; ++j)
+    skewed.v[0*4+j] += 0.01f * skewed.v[1*4+j];
+  assert(mtx44OrthonormalDrift(&skewed) > 1.0f);
+  mtx44Orthonormalize(&skewed);
+  assert(mtx44OrthonormalDrift(&skewed) < 1.0e-5f);
+  assert(nearlyEqual(skewed, rotations[1], 1.0e-2f));
+
+  // drift every other matrix with many small incremental rotations
+  for(size_t n = 0; n < count; n += 2)
+  {
+    glm::vec3 axis = randomVector(gen, dist);
+    for(size_t i = 0; i < 2000; ++i)
+    {
+      mtx44RotateX(&m[n], 0.01f);
+      mtx44RotateY(&m[n], 0.02f);
+      mtx44RotateZ(&m[n], 0.03f);
+      mtx44Rotate(&m[n], (vec3f){ axis.x, axis.y, axis.z }, 0.04f);
+    }
+
+    // and a deliberate skew on top of the rounding drift
+    m[n].v[0] += 1.0e-3f;
+    assert(mtx44OrthonormalDrift(&m[n]) > 1.0e-4f);
+  }
+
+  std::vector<mtx44> fixed = m;
+  assert(mtx44OrthonormalizeDriftBatch(fixed.data(), 1.0e-4f, count) == count / 2);
+
+  for(size_t n = 0; n < count; ++n)
+  {
+    assert(mtx44OrthonormalDrift(&fixed[n]) < 1.0e-5f);
+
+    // the correction is small and leaves translation alone
+    assert(nearlyEqual(fixed[n], m[n], 1.0e-2f));
+    assert(fixed[n].v[12] == m[n].v[12] && fixed[n].v[13] == m[n].v[13] && fixed[n].v[14] == m[n].v[14]);
+
+    // clean matrices were not touched
+    if(n % 2)
+      assert(std::memcmp(&fixed[n], &m[n], sizeof(mtx44)) == 0);
+  }
+
+  mtx44OrthonormalizeBatch(m.data(), count);
+  for(size_t n = 0; n < count; ++n)
+  {
+    assert(mtx44OrthonormalDrift(&m[n]) < 1.0e-5f);
+
+    // right-handed
+    vec3f x = { m[n].v[0], m[n].v[1], m[n].v[2] };
+    vec3f y = { m[n].v[4], m[n].v[5], m[n].v[6] };
+    vec3f z = { m[n].v[8], m[n].v[9], m[n].v[10] };
+    assert(vec3fDot(vec3fCross(x, y), z) > 0.0f);
+  }
+}
+
+static void
+check_profile(generator_t &gen, distribution_t &dist)
+{
+  std::vector<profileEntry> entries(PROFILE_MAX_FUNCTIONS);
+
+  profileReset();
+
+#ifdef GS_MATH_PROFILE
+  mtx44 lhs, rhs;
+  randomMatrix(lhs, gen, dist);
+  randomMatrix(rhs, gen, dist);
+
+  auto multiply = [&](size_t count)
+  {
+    mtx44 m;
+    for(size_t i = 0; i < count; ++i)
+      mtx44Multiply(&m, &lhs, &rhs);
+  };
+
+  // counts from exited threads must survive
+  multiply(100);
+  std::vector<std::thread> threads;
+  for(size_t i = 0; i < 4; ++i)
+    threads.emplace_back(multiply, 50);
+  for(auto &t : threads)
+    t.join();
+
+  auto find = [&](const char *name) -> const profileEntry*
+  {
+    size_t count = profileSnapshot(entries.data(), entries.size());
+    assert(count <= entries.size());
+
+    for(size_t i = 0; i < count; ++i)
+    {
+      if(std::strcmp(entries[i].name, name) == 0)
+        return &entries[i];
+    }
+
+    return nullptr;
+  };
+
+  const profileEntry *e = find("mtx44Multiply");
+  assert(e && e->calls == 300 && e->ticks > 0);
+  assert(!find("mtx44Identity") || find("mtx44Identity")->calls == 0);
+
+  FILE *fp = std::fopen("/dev/null", "w");
+  assert(fp);
+  profileDump(fp);
+  std::fclose(fp);
+
+  profileReset();
+  e = find("mtx44Multiply");
+  assert(e && e->calls == 0 && e->ticks == 0);
+
+  multiply(7);
+  e = find("mtx44Multiply");
+  assert(e && e->calls == 7);
+#else
+  (void)gen;
+  (void)dist;
+  assert(profileSnapshot(entries.data(), entries.size()) == 0);
+  profileDump(stdout);
+#endif
+}
+
 int main(int argc, char *argv[])
 {
   std::random_device rd;
@@ -437,6 +2472,28 @@ int main(int argc, char *argv[])
 
   check_matrix(gen, dist);
   check_quaternion(gen, dist);
+  check_bounds(gen, dist);
+  check_rays(gen, dist);
+  check_bvh(gen, dist);
+  check_morton(gen);
+  check_hash_grid(gen, dist);
+  check_thread_pool(gen, dist);
+  check_arena(gen, dist);
+  check_triple_buffer();
+  check_pica(gen, dist);
+  check_normal_matrix(gen, dist);
+  check_camera(gen, dist);
+  check_quat_integrate(gen, dist);
+  check_constexpr(gen, dist);
+  check_math_file(gen, dist);
+  check_splines(gen, dist);
+  check_octahedral(gen, dist);
+  check_rotation_cache(gen, dist);
+  check_skeleton(gen, dist);
+  check_particles(gen, dist);
+  check_contacts(gen, dist);
+  check_orthonormalize(gen, dist);
+  check_profile(gen, dist);
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,16 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+u32 mathFileChecksum(const void *data, size_t size)
+{
+  PROFILE_FUNCTION();
+
+  const unsigned char *p = (const unsigned char*)data;
+  u32    hash = 0x811C9DC5u;
+  size_t i;
+
+  for(i = 0; i < size; ++i)
+    hash = (hash ^ p[i]) * 0x01000193u;
+
+  return hash;
+}
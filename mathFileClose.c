@@ -0,0 +1,21 @@
+#include <stdlib.h>
+#include <string.h>
+#ifndef ARM11
+#include <sys/mman.h>
+#endif
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mathFileClose(mathFile *f)
+{
+  PROFILE_FUNCTION();
+
+#ifndef ARM11
+  if(f->mapped)
+    munmap((void*)f->base, f->size);
+#endif
+
+  free(f->storage);
+
+  memset(f, 0, sizeof(*f));
+}
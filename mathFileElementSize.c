@@ -0,0 +1,20 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+size_t mathFileElementSize(u32 type)
+{
+  PROFILE_FUNCTION();
+
+  switch(type)
+  {
+    case MATH_FILE_BYTES: return 1;
+    case MATH_FILE_FLOAT: return sizeof(float);
+    case MATH_FILE_VEC3F: return sizeof(vec3f);
+    case MATH_FILE_VEC4F: return sizeof(vec4f);
+    case MATH_FILE_QUAT:  return sizeof(quat);
+    case MATH_FILE_MTX44: return sizeof(mtx44);
+    case MATH_FILE_S32:   return sizeof(s32);
+  }
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+const void* mathFileFind(const mathFile *f, u32 type, u32 id, size_t *count)
+{
+  PROFILE_FUNCTION();
+
+  u32 i;
+
+  if(!f->header)
+    return NULL;
+
+  for(i = 0; i < f->header->sectionCount; ++i)
+  {
+    if(f->sections[i].type == type && f->sections[i].id == id)
+    {
+      if(count)
+        *count = f->sections[i].count;
+
+      return (const char*)f->base + f->sections[i].offset;
+    }
+  }
+
+  if(count)
+    *count = 0;
+
+  return NULL;
+}
@@ -0,0 +1,47 @@
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int mathFileLoad(mathFile *f, const void *data, size_t size)
+{
+  PROFILE_FUNCTION();
+
+  const mathFileHeader  *header   = (const mathFileHeader*)data;
+  const mathFileSection *sections;
+  u32                    i;
+
+  memset(f, 0, sizeof(*f));
+
+  if(!data || size < sizeof(*header) || ((size_t)data & 15))
+    return 0;
+
+  if(header->magic != MATH_FILE_MAGIC || header->endian != 0x01020304u
+  || header->version == 0 || header->version > MATH_FILE_VERSION
+  || header->fileSize != size)
+    return 0;
+
+  /* section table must lie within the file */
+  if(header->tableOffset < sizeof(*header) || header->tableOffset > size
+  || (header->tableOffset & 7)
+  || header->sectionCount > (size - header->tableOffset) / sizeof(mathFileSection))
+    return 0;
+
+  sections = (const mathFileSection*)((const char*)data + header->tableOffset);
+
+  for(i = 0; i < header->sectionCount; ++i)
+  {
+    u64 elementSize = mathFileElementSize(sections[i].type);
+
+    if(elementSize == 0 || (sections[i].offset % MATH_FILE_ALIGN) != 0
+    || sections[i].offset > size
+    || sections[i].count > (size - sections[i].offset) / elementSize)
+      return 0;
+  }
+
+  f->base     = data;
+  f->size     = size;
+  f->header   = header;
+  f->sections = sections;
+
+  return 1;
+}
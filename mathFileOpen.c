@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef ARM11
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#ifdef ARM11
+/* no mmap; read into an aligned heap copy */
+int mathFileOpen(mathFile *f, const char *path)
+{
+  PROFILE_FUNCTION();
+
+  FILE *fp;
+  void *storage = NULL;
+  long  size;
+
+  memset(f, 0, sizeof(*f));
+
+  fp = fopen(path, "rb");
+  if(!fp)
+    return 0;
+
+  if(fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) <= 0
+  || fseek(fp, 0, SEEK_SET) != 0
+  || posix_memalign(&storage, MATH_FILE_ALIGN, size) != 0)
+  {
+    fclose(fp);
+    return 0;
+  }
+
+  if(fread(storage, 1, size, fp) != (size_t)size
+  || !mathFileLoad(f, storage, size))
+  {
+    fclose(fp);
+    free(storage);
+    return 0;
+  }
+
+  fclose(fp);
+  f->storage = storage;
+
+  return 1;
+}
+#else
+int mathFileOpen(mathFile *f, const char *path)
+{
+  PROFILE_FUNCTION();
+
+  struct stat st;
+  void       *base;
+  int         fd;
+
+  memset(f, 0, sizeof(*f));
+
+  fd = open(path, O_RDONLY);
+  if(fd < 0)
+    return 0;
+
+  if(fstat(fd, &st) != 0 || st.st_size <= 0)
+  {
+    close(fd);
+    return 0;
+  }
+
+  base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if(base == MAP_FAILED)
+    return 0;
+
+  if(!mathFileLoad(f, base, st.st_size))
+  {
+    munmap(base, st.st_size);
+    return 0;
+  }
+
+  f->mapped = 1;
+
+  return 1;
+}
+#endif
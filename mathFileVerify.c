@@ -0,0 +1,22 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int mathFileVerify(const mathFile *f)
+{
+  PROFILE_FUNCTION();
+
+  u32 i;
+
+  if(!f->header)
+    return 0;
+
+  for(i = 0; i < f->header->sectionCount; ++i)
+  {
+    const mathFileSection *s = &f->sections[i];
+
+    if(mathFileChecksum((const char*)f->base + s->offset, s->count * mathFileElementSize(s->type)) != s->checksum)
+      return 0;
+  }
+
+  return 1;
+}
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int mathFileWrite(const char *path, const mathFileSource *sections, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  static const unsigned char zero[MATH_FILE_ALIGN];
+
+  mathFileHeader   header;
+  mathFileSection *table;
+  FILE            *fp;
+  u64              offset;
+  size_t           i;
+  u32              probe = 1;
+  int              ok = 1;
+
+  /* data is written as-is */
+  if(*(unsigned char*)&probe != 1)
+    return 0;
+
+  if(count > (size_t)0xFFFFFFFFu)
+    return 0;
+
+  table = (mathFileSection*)calloc(count ? count : 1, sizeof(*table));
+  if(!table)
+    return 0;
+
+  offset = sizeof(header) + count * sizeof(*table);
+
+  for(i = 0; i < count; ++i)
+  {
+    size_t elementSize = mathFileElementSize(sections[i].type);
+    size_t size        = sections[i].count * elementSize;
+
+    if(elementSize == 0 || size / elementSize != sections[i].count
+    || (size && !sections[i].data))
+    {
+      free(table);
+      return 0;
+    }
+
+    offset = (offset + MATH_FILE_ALIGN - 1) & ~(u64)(MATH_FILE_ALIGN - 1);
+
+    table[i].type     = sections[i].type;
+    table[i].id       = sections[i].id;
+    table[i].offset   = offset;
+    table[i].count    = sections[i].count;
+    table[i].checksum = mathFileChecksum(sections[i].data, size);
+    table[i].reserved = 0;
+
+    offset += size;
+  }
+
+  header.magic        = MATH_FILE_MAGIC;
+  header.version      = MATH_FILE_VERSION;
+  header.endian       = 0x01020304u;
+  header.sectionCount = (u32)count;
+  header.fileSize     = offset;
+  header.tableOffset  = sizeof(header);
+
+  fp = fopen(path, "wb");
+  if(!fp)
+  {
+    free(table);
+    return 0;
+  }
+
+  ok = fwrite(&header, sizeof(header), 1, fp) == 1
+    && (count == 0 || fwrite(table, sizeof(*table), count, fp) == count);
+
+  offset = sizeof(header) + count * sizeof(*table);
+  for(i = 0; ok && i < count; ++i)
+  {
+    size_t size = sections[i].count * mathFileElementSize(sections[i].type);
+
+    ok = fwrite(zero, 1, table[i].offset - offset, fp) == table[i].offset - offset
+      && (size == 0 || fwrite(sections[i].data, 1, size, fp) == size);
+
+    offset = table[i].offset + size;
+  }
+
+  if(fclose(fp) != 0)
+    ok = 0;
+
+  if(!ok)
+    remove(path);
+
+  free(table);
+  return ok;
+}
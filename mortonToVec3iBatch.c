@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mortonToVec3iBatch(vec3i *v, const u64 *codes, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+
+  for(i = 0; i < count; ++i)
+    v[i] = mortonToVec3i(codes[i]);
+}
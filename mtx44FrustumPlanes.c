@@ -0,0 +1,26 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44FrustumPlanes(vec4f planes[6], const mtx44 *m)
+{
+  PROFILE_FUNCTION();
+
+  int i, j;
+
+  /* Gribb-Hartmann: a point is inside where row3 +/- row0..2 is >= 0 */
+  for(i = 0; i < 3; ++i)
+  {
+    for(j = 0; j < 2; ++j)
+    {
+      float s   = j ? -1.0f : 1.0f;
+      vec4f p   = { m->v[0*4+3] + s*m->v[0*4+i],
+                    m->v[1*4+3] + s*m->v[1*4+i],
+                    m->v[2*4+3] + s*m->v[2*4+i],
+                    m->v[3*4+3] + s*m->v[3*4+i] };
+      float len = sqrtf(p.x*p.x + p.y*p.y + p.z*p.z);
+
+      planes[i*2+j] = (vec4f){ p.x/len, p.y/len, p.z/len, p.w/len };
+    }
+  }
+}
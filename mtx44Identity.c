@@ -1,7 +1,10 @@
 #include "gs_math.h"
+#include "gs_profile.h"
 
 void mtx44Identity(mtx44 *m)
 {
+  PROFILE_FUNCTION();
+
   int i, j;
   for(i = 0; i < 4; ++i)
   {
@@ -0,0 +1,56 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int mtx44Inverse(mtx44 *out, const mtx44 *m)
+{
+  PROFILE_FUNCTION();
+
+  const float *a = m->v;
+  float       inv[16], det;
+  int         i;
+
+  /* cofactor expansion via the 2x2 sub-determinants of the column pairs */
+  float s0 = a[0]*a[5]  - a[4]*a[1];
+  float s1 = a[0]*a[6]  - a[4]*a[2];
+  float s2 = a[0]*a[7]  - a[4]*a[3];
+  float s3 = a[1]*a[6]  - a[5]*a[2];
+  float s4 = a[1]*a[7]  - a[5]*a[3];
+  float s5 = a[2]*a[7]  - a[6]*a[3];
+
+  float c5 = a[10]*a[15] - a[14]*a[11];
+  float c4 = a[9]*a[15]  - a[13]*a[11];
+  float c3 = a[9]*a[14]  - a[13]*a[10];
+  float c2 = a[8]*a[15]  - a[12]*a[11];
+  float c1 = a[8]*a[14]  - a[12]*a[10];
+  float c0 = a[8]*a[13]  - a[12]*a[9];
+
+  det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+  if(det == 0.0f)
+    return 0;
+
+  inv[0]  = ( a[5]*c5  - a[6]*c4  + a[7]*c3);
+  inv[1]  = (-a[1]*c5  + a[2]*c4  - a[3]*c3);
+  inv[2]  = ( a[13]*s5 - a[14]*s4 + a[15]*s3);
+  inv[3]  = (-a[9]*s5  + a[10]*s4 - a[11]*s3);
+
+  inv[4]  = (-a[4]*c5  + a[6]*c2  - a[7]*c1);
+  inv[5]  = ( a[0]*c5  - a[2]*c2  + a[3]*c1);
+  inv[6]  = (-a[12]*s5 + a[14]*s2 - a[15]*s1);
+  inv[7]  = ( a[8]*s5  - a[10]*s2 + a[11]*s1);
+
+  inv[8]  = ( a[4]*c4  - a[5]*c2  + a[7]*c0);
+  inv[9]  = (-a[0]*c4  + a[1]*c2  - a[3]*c0);
+  inv[10] = ( a[12]*s4 - a[13]*s2 + a[15]*s0);
+  inv[11] = (-a[8]*s4  + a[9]*s2  - a[11]*s0);
+
+  inv[12] = (-a[4]*c3  + a[5]*c1  - a[6]*c0);
+  inv[13] = ( a[0]*c3  - a[1]*c1  + a[2]*c0);
+  inv[14] = (-a[12]*s3 + a[13]*s1 - a[14]*s0);
+  inv[15] = ( a[8]*s3  - a[9]*s1  + a[10]*s0);
+
+  det = 1.0f / det;
+  for(i = 0; i < 16; ++i)
+    out->v[i] = inv[i] * det;
+
+  return 1;
+}
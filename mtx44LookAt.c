@@ -0,0 +1,20 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44LookAt(mtx44 *m, vec3f eye, vec3f target, vec3f up)
+{
+  PROFILE_FUNCTION();
+
+  vec3f f = vec3fNormalize(vec3fSubtract(target, eye));
+  vec3f s = vec3fNormalize(vec3fCross(f, up));
+  vec3f u = vec3fCross(s, f);
+
+  m->v[0*4+0] = s.x; m->v[0*4+1] = u.x; m->v[0*4+2] = -f.x; m->v[0*4+3] = 0.0f;
+  m->v[1*4+0] = s.y; m->v[1*4+1] = u.y; m->v[1*4+2] = -f.y; m->v[1*4+3] = 0.0f;
+  m->v[2*4+0] = s.z; m->v[2*4+1] = u.z; m->v[2*4+2] = -f.z; m->v[2*4+3] = 0.0f;
+
+  m->v[3*4+0] = -vec3fDot(s, eye);
+  m->v[3*4+1] = -vec3fDot(u, eye);
+  m->v[3*4+2] =  vec3fDot(f, eye);
+  m->v[3*4+3] = 1.0f;
+}
@@ -1,7 +1,10 @@
 #include "gs_math.h"
+#include "gs_profile.h"
 
 void mtx44Multiply(mtx44 *m, const mtx44 *lhs, const mtx44 *rhs)
 {
+  PROFILE_FUNCTION();
+
   int i, j;
 
   for(i = 0; i < 4; ++i)
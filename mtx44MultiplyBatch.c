@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44MultiplyBatch(mtx44 *m, const mtx44 *lhs, const mtx44 *rhs, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+
+  for(n = 0; n < count; ++n)
+    mtx44Multiply(&m[n], &lhs[n], &rhs[n]);
+}
@@ -0,0 +1,24 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+typedef struct
+{
+  mtx44       *m;
+  const mtx44 *lhs;
+  const mtx44 *rhs;
+} args;
+
+static void
+run(void *p, size_t first, size_t count)
+{
+  args *a = p;
+  mtx44MultiplyBatch(a->m + first, a->lhs + first, a->rhs + first, count);
+}
+
+void mtx44MultiplyBatchParallel(threadPool *pool, mtx44 *m, const mtx44 *lhs, const mtx44 *rhs, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  args a = { m, lhs, rhs };
+  threadPoolFor(pool, count, sizeof(mtx44), run, &a);
+}
@@ -0,0 +1,29 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44NormalMatrix(mtx44 *out, const mtx44 *m)
+{
+  PROFILE_FUNCTION();
+
+  vec3f a = { m->v[0*4+0], m->v[0*4+1], m->v[0*4+2] };
+  vec3f b = { m->v[1*4+0], m->v[1*4+1], m->v[1*4+2] };
+  vec3f c = { m->v[2*4+0], m->v[2*4+1], m->v[2*4+2] };
+
+  /* the columns of the cofactor matrix are b x c, c x a and a x b, and
+   * a . (b x c) is the determinant
+   */
+  vec3f bc  = vec3fCross(b, c);
+  vec3f ca  = vec3fCross(c, a);
+  vec3f ab  = vec3fCross(a, b);
+  float det = vec3fDot(a, bc);
+  float inv = det != 0.0f ? 1.0f / det : 1.0f;
+
+  bc = vec3fScale(bc, inv);
+  ca = vec3fScale(ca, inv);
+  ab = vec3fScale(ab, inv);
+
+  out->v[0*4+0] = bc.x; out->v[0*4+1] = bc.y; out->v[0*4+2] = bc.z; out->v[0*4+3] = 0.0f;
+  out->v[1*4+0] = ca.x; out->v[1*4+1] = ca.y; out->v[1*4+2] = ca.z; out->v[1*4+3] = 0.0f;
+  out->v[2*4+0] = ab.x; out->v[2*4+1] = ab.y; out->v[2*4+2] = ab.z; out->v[2*4+3] = 0.0f;
+  out->v[3*4+0] = 0.0f; out->v[3*4+1] = 0.0f; out->v[3*4+2] = 0.0f; out->v[3*4+3] = 1.0f;
+}
@@ -0,0 +1,31 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44NormalMatrixBatch(mtx44 *out, const mtx44 *m, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+
+  /* same as mtx44NormalMatrix, written out so the loop body inlines */
+  for(n = 0; n < count; ++n)
+  {
+    const float *v = m[n].v;
+    float       *o = out[n].v;
+
+    vec3f a = { v[0*4+0], v[0*4+1], v[0*4+2] };
+    vec3f b = { v[1*4+0], v[1*4+1], v[1*4+2] };
+    vec3f c = { v[2*4+0], v[2*4+1], v[2*4+2] };
+
+    vec3f bc  = vec3fCross(b, c);
+    vec3f ca  = vec3fCross(c, a);
+    vec3f ab  = vec3fCross(a, b);
+    float det = vec3fDot(a, bc);
+    float inv = det != 0.0f ? 1.0f / det : 1.0f;
+
+    o[0*4+0] = bc.x*inv; o[0*4+1] = bc.y*inv; o[0*4+2] = bc.z*inv; o[0*4+3] = 0.0f;
+    o[1*4+0] = ca.x*inv; o[1*4+1] = ca.y*inv; o[1*4+2] = ca.z*inv; o[1*4+3] = 0.0f;
+    o[2*4+0] = ab.x*inv; o[2*4+1] = ab.y*inv; o[2*4+2] = ab.z*inv; o[2*4+3] = 0.0f;
+    o[3*4+0] = 0.0f;     o[3*4+1] = 0.0f;     o[3*4+2] = 0.0f;     o[3*4+3] = 1.0f;
+  }
+}
@@ -0,0 +1,23 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44NormalMatrixUniform(mtx44 *out, const mtx44 *m)
+{
+  PROFILE_FUNCTION();
+
+  float ss  = m->v[0*4+0]*m->v[0*4+0] + m->v[0*4+1]*m->v[0*4+1] + m->v[0*4+2]*m->v[0*4+2];
+  float inv = ss != 0.0f ? 1.0f / ss : 1.0f;
+  int   i, j;
+
+  for(i = 0; i < 3; ++i)
+  {
+    for(j = 0; j < 3; ++j)
+      out->v[i*4+j] = m->v[i*4+j] * inv;
+    out->v[i*4+3] = 0.0f;
+  }
+
+  out->v[3*4+0] = 0.0f;
+  out->v[3*4+1] = 0.0f;
+  out->v[3*4+2] = 0.0f;
+  out->v[3*4+3] = 1.0f;
+}
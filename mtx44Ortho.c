@@ -1,6 +1,16 @@
 #include "gs_math.h"
+#include "gs_profile.h"
 
 void mtx44Ortho(mtx44 *m, float left, float right, float bottom, float top, float near, float far)
 {
-  /* TODO: implement this */
+  PROFILE_FUNCTION();
+
+  mtx44Identity(m);
+
+  m->v[0*4+0] = 2.0f / (right - left);
+  m->v[1*4+1] = 2.0f / (top - bottom);
+  m->v[2*4+2] = -2.0f / (far - near);
+  m->v[3*4+0] = -(right + left) / (right - left);
+  m->v[3*4+1] = -(top + bottom) / (top - bottom);
+  m->v[3*4+2] = -(far + near) / (far - near);
 }
@@ -0,0 +1,29 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44Orthonormalize(mtx44 *m)
+{
+  PROFILE_FUNCTION();
+
+  float *v = m->v;
+
+  vec3f x = vec3fNormalize((vec3f){ v[0*4+0], v[0*4+1], v[0*4+2] });
+  vec3f y = vec3fNormalize((vec3f){ v[1*4+0], v[1*4+1], v[1*4+2] });
+  vec3f z;
+
+  /* rotate x and y towards each other by half the excess angle each; this
+   * needs unit columns, so scale is dropped first
+   */
+  float e = 0.5f * vec3fDot(x, y);
+  vec3f xo = vec3fSubtract(x, vec3fScale(y, e));
+  vec3f yo = vec3fSubtract(y, vec3fScale(x, e));
+
+  x = vec3fNormalize(xo);
+  y = vec3fNormalize(yo);
+  z = vec3fNormalize(vec3fCross(x, y));
+
+  v[0*4+0] = x.x; v[0*4+1] = x.y; v[0*4+2] = x.z;
+  v[1*4+0] = y.x; v[1*4+1] = y.y; v[1*4+2] = y.z;
+  v[2*4+0] = z.x; v[2*4+1] = z.y; v[2*4+2] = z.z;
+}
@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44OrthonormalizeBatch(mtx44 *m, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+
+  for(n = 0; n < count; ++n)
+    mtx44Orthonormalize(&m[n]);
+}
@@ -0,0 +1,21 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+size_t mtx44OrthonormalizeDriftBatch(mtx44 *m, float tolerance, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n, fixed = 0;
+
+  /* the check is six dot-products; most matrices stop there */
+  for(n = 0; n < count; ++n)
+  {
+    if(mtx44OrthonormalDrift(&m[n]) > tolerance)
+    {
+      mtx44Orthonormalize(&m[n]);
+      ++fixed;
+    }
+  }
+
+  return fixed;
+}
@@ -1,6 +1,20 @@
+#include <math.h>
 #include "gs_math.h"
+#include "gs_profile.h"
 
 void mtx44Perpective(mtx44 *m, float fovy, float aspect, float near, float far)
 {
-  /* TODO: implement this */
+  PROFILE_FUNCTION();
+
+  float f = 1.0f / tanf(fovy / 2.0f);
+  int   i;
+
+  for(i = 0; i < 16; ++i)
+    m->v[i] = 0.0f;
+
+  m->v[0*4+0] = f * aspect;
+  m->v[1*4+1] = f;
+  m->v[2*4+2] = (far + near) / (near - far);
+  m->v[2*4+3] = -1.0f;
+  m->v[3*4+2] = 2.0f * far * near / (near - far);
 }
@@ -1,8 +1,11 @@
 #include <math.h>
 #include "gs_math.h"
+#include "gs_profile.h"
 
 void mtx44Rotate(mtx44 *m, vec3f axis, float r)
 {
+  PROFILE_FUNCTION();
+
   axis = vec3fNormalize(axis);
 
   mtx44 rhs, result;
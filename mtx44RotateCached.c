@@ -0,0 +1,28 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44RotateCached(mtx44 *m, rotationCache *c, vec3f axis, u32 step)
+{
+  PROFILE_FUNCTION();
+
+  const float *rhs = rotationCacheLookup(c, axis, step);
+
+  mtx44 result;
+
+  int i, j;
+
+  for(i = 0; i < 3; ++i)
+  {
+    for(j = 0; j < 4; ++j)
+    {
+      result.v[i*4+j] = m->v[0*4+j]*rhs[i*3+0]
+                      + m->v[1*4+j]*rhs[i*3+1]
+                      + m->v[2*4+j]*rhs[i*3+2];
+    }
+  }
+
+  for(j = 0; j < 4; ++j)
+    result.v[3*4+j] = m->v[3*4+j];
+
+  *m = result;
+}
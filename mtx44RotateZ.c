@@ -1,8 +1,11 @@
 #include <math.h>
 #include "gs_math.h"
+#include "gs_profile.h"
 
 void mtx44RotateZ(mtx44 *m, float r)
 {
+  PROFILE_FUNCTION();
+
   float s = sinf(r);
   float c = cosf(r);
 
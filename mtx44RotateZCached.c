@@ -0,0 +1,29 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44RotateZCached(mtx44 *m, const rotationCache *c, u32 step)
+{
+  PROFILE_FUNCTION();
+
+  const float *sc = rotationCacheSinCos(c, 2 * (step % c->steps));
+  float s  = sc[0];
+  float co = sc[1];
+
+  mtx44 tmp;
+
+  int j;
+
+  for(j = 0; j < 4; ++j)
+    tmp.v[0*4+j] = m->v[0*4+j]*co + m->v[1*4+j]*s;
+
+  for(j = 0; j < 4; ++j)
+    tmp.v[1*4+j] = m->v[0*4+j]*-s + m->v[1*4+j]*co;
+
+  for(j = 0; j < 4; ++j)
+    tmp.v[2*4+j] = m->v[2*4+j];
+
+  for(j = 0; j < 4; ++j)
+    tmp.v[3*4+j] = m->v[3*4+j];
+
+  *m = tmp;
+}
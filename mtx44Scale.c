@@ -1,7 +1,10 @@
 #include "gs_math.h"
+#include "gs_profile.h"
 
 void mtx44Scale(mtx44 *m, float x, float y, float z)
 {
+  PROFILE_FUNCTION();
+
   int j;
 
   for(j = 0; j < 4; ++j)
@@ -0,0 +1,59 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#define VSH_FLOATUNIFORM_CONFIG 0x02C0
+#define GSH_FLOATUNIFORM_CONFIG 0x0290
+
+/* largest parameter count per write command (at most 256) that holds a
+ * whole number of matrices in either format
+ */
+#define CHUNK 240
+
+size_t mtx44ToPicaCommands(u32 *cmd, const mtx44 *m, size_t count, u32 reg, int f24, int geometry)
+{
+  PROFILE_FUNCTION();
+
+  u32    config = geometry ? GSH_FLOATUNIFORM_CONFIG : VSH_FLOATUNIFORM_CONFIG;
+  size_t stride = f24 ? 12 : 16;
+  size_t words  = count * stride;
+  size_t size   = 2;
+  size_t pos;
+
+  /* each write command is its first parameter, a header, the remaining
+   * parameters and, if needed, a padding word to keep 8-byte alignment
+   */
+  for(pos = 0; pos < words; pos += CHUNK)
+  {
+    size_t n = words - pos < CHUNK ? words - pos : CHUNK;
+    size += 1 + n + ((n - 1) & 1);
+  }
+
+  if(!cmd)
+    return size;
+
+  /* select the first register; bit 31 selects float32 mode */
+  *cmd++ = (f24 ? 0 : 0x80000000) | reg;
+  *cmd++ = config | 0xF << 16;
+
+  for(pos = 0; pos < words; pos += CHUNK)
+  {
+    size_t n = words - pos < CHUNK ? words - pos : CHUNK;
+
+    /* convert straight into place one word late, then slide the first word
+     * down to make room for the header
+     */
+    if(f24)
+      mtx44ToPicaF24(cmd + 1, m + pos / stride, n / stride);
+    else
+      mtx44ToPicaF32(cmd + 1, m + pos / stride, n / stride);
+
+    cmd[0] = cmd[1];
+    cmd[1] = (config + 1) | 0xF << 16 | (u32)(n - 1) << 20;
+    cmd   += 1 + n;
+
+    if((n - 1) & 1)
+      *cmd++ = 0;
+  }
+
+  return size;
+}
@@ -0,0 +1,28 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44ToPicaF24(u32 *out, const mtx44 *m, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+  int    i;
+
+  for(n = 0; n < count; ++n, out += 12)
+  {
+    u32 f[16];
+
+    for(i = 0; i < 16; ++i)
+      f[i] = floatToF24(m[n].v[i]);
+
+    /* row i is (x, y, z, w) = column-major elements i, 4+i, 8+i, 12+i */
+    for(i = 0; i < 4; ++i)
+    {
+      u32 x = f[0*4+i], y = f[1*4+i], z = f[2*4+i], w = f[3*4+i];
+
+      out[i*3+0] = w << 8  | z >> 16;
+      out[i*3+1] = z << 16 | y >> 8;
+      out[i*3+2] = y << 24 | x;
+    }
+  }
+}
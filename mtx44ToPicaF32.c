@@ -0,0 +1,27 @@
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44ToPicaF32(u32 *out, const mtx44 *m, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+  int    i;
+
+  for(n = 0; n < count; ++n, out += 16)
+  {
+    float row[16];
+
+    /* row i, reversed to w, z, y, x */
+    for(i = 0; i < 4; ++i)
+    {
+      row[i*4+0] = m[n].v[3*4+i];
+      row[i*4+1] = m[n].v[2*4+i];
+      row[i*4+2] = m[n].v[1*4+i];
+      row[i*4+3] = m[n].v[0*4+i];
+    }
+
+    memcpy(out, row, sizeof(row));
+  }
+}
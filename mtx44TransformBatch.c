@@ -0,0 +1,19 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44TransformBatch(vec3f *out, const mtx44 *m, const vec3f *in, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  const float *v = m->v;
+  size_t      n;
+
+  for(n = 0; n < count; ++n)
+  {
+    vec3f p = in[n];
+
+    out[n] = (vec3f){ v[0*4+0]*p.x + v[1*4+0]*p.y + v[2*4+0]*p.z + v[3*4+0],
+                      v[0*4+1]*p.x + v[1*4+1]*p.y + v[2*4+1]*p.z + v[3*4+1],
+                      v[0*4+2]*p.x + v[1*4+2]*p.y + v[2*4+2]*p.z + v[3*4+2] };
+  }
+}
@@ -0,0 +1,24 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+typedef struct
+{
+  vec3f       *out;
+  const mtx44 *m;
+  const vec3f *in;
+} args;
+
+static void
+run(void *p, size_t first, size_t count)
+{
+  args *a = p;
+  mtx44TransformBatch(a->out + first, a->m, a->in + first, count);
+}
+
+void mtx44TransformBatchParallel(threadPool *pool, vec3f *out, const mtx44 *m, const vec3f *in, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  args a = { out, m, in };
+  threadPoolFor(pool, count, sizeof(vec3f), run, &a);
+}
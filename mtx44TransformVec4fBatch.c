@@ -0,0 +1,26 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void mtx44TransformVec4fBatch(vec4f *out, const mtx44 *m, const vec4f *in, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  const float *v = m->v;
+  size_t      n;
+
+  /* with the padding each point is one aligned 16-byte load and store, and
+   * the matrix columns are used whole, so this maps onto 4-wide SIMD
+   */
+  for(n = 0; n < count; ++n)
+  {
+    vec4f p = in[n];
+    vec4f r;
+
+    r.x = v[0*4+0]*p.x + v[1*4+0]*p.y + v[2*4+0]*p.z + v[3*4+0];
+    r.y = v[0*4+1]*p.x + v[1*4+1]*p.y + v[2*4+1]*p.z + v[3*4+1];
+    r.z = v[0*4+2]*p.x + v[1*4+2]*p.y + v[2*4+2]*p.z + v[3*4+2];
+    r.w = 1.0f;
+
+    out[n] = r;
+  }
+}
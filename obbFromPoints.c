@@ -0,0 +1,137 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+/* diagonalize a symmetric 3x3 matrix with cyclic Jacobi rotations; the
+ * eigenvectors are left in the columns of v
+ */
+static void
+jacobi(float a[3][3], float v[3][3])
+{
+  int sweep, p, q, k;
+
+  for(p = 0; p < 3; ++p)
+  {
+    for(q = 0; q < 3; ++q)
+      v[p][q] = (p == q) ? 1.0f : 0.0f;
+  }
+
+  for(sweep = 0; sweep < 16; ++sweep)
+  {
+    float off = a[0][1]*a[0][1] + a[0][2]*a[0][2] + a[1][2]*a[1][2];
+    float dia = a[0][0]*a[0][0] + a[1][1]*a[1][1] + a[2][2]*a[2][2];
+
+    if(off <= 1e-12f * dia)
+      return;
+
+    for(p = 0; p < 2; ++p)
+    {
+      for(q = p+1; q < 3; ++q)
+      {
+        float theta, t, c, s;
+
+        if(a[p][q] == 0.0f)
+          continue;
+
+        theta = (a[q][q] - a[p][p]) / (2.0f * a[p][q]);
+        t     = 1.0f / (fabsf(theta) + sqrtf(theta*theta + 1.0f));
+        if(theta < 0.0f)
+          t = -t;
+        c = 1.0f / sqrtf(t*t + 1.0f);
+        s = t*c;
+
+        for(k = 0; k < 3; ++k)
+        {
+          float akp = a[k][p], akq = a[k][q];
+          a[k][p] = c*akp - s*akq;
+          a[k][q] = s*akp + c*akq;
+        }
+
+        for(k = 0; k < 3; ++k)
+        {
+          float apk = a[p][k], aqk = a[q][k];
+          a[p][k] = c*apk - s*aqk;
+          a[q][k] = s*apk + c*aqk;
+        }
+
+        for(k = 0; k < 3; ++k)
+        {
+          float vkp = v[k][p], vkq = v[k][q];
+          v[k][p] = c*vkp - s*vkq;
+          v[k][q] = s*vkp + c*vkq;
+        }
+      }
+    }
+  }
+}
+
+void obbFromPoints(obb *box, const vec3f *points, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  float  cov[3][3], v[3][3];
+  float  xx = 0.0f, xy = 0.0f, xz = 0.0f, yy = 0.0f, yz = 0.0f, zz = 0.0f;
+  float  lo[3], hi[3];
+  vec3f  mean = { 0.0f, 0.0f, 0.0f };
+  size_t i;
+  int    j;
+
+  if(count == 0)
+  {
+    box->center  = mean;
+    box->axis[0] = (vec3f){ 1.0f, 0.0f, 0.0f };
+    box->axis[1] = (vec3f){ 0.0f, 1.0f, 0.0f };
+    box->axis[2] = (vec3f){ 0.0f, 0.0f, 1.0f };
+    box->extent  = (vec3f){ -1.0f, -1.0f, -1.0f };
+    return;
+  }
+
+  for(i = 0; i < count; ++i)
+    mean = vec3fAdd(mean, points[i]);
+  mean = vec3fScale(mean, 1.0f / count);
+
+  for(i = 0; i < count; ++i)
+  {
+    vec3f d = vec3fSubtract(points[i], mean);
+
+    xx += d.x*d.x; xy += d.x*d.y; xz += d.x*d.z;
+    yy += d.y*d.y; yz += d.y*d.z; zz += d.z*d.z;
+  }
+
+  cov[0][0] = xx; cov[0][1] = xy; cov[0][2] = xz;
+  cov[1][0] = xy; cov[1][1] = yy; cov[1][2] = yz;
+  cov[2][0] = xz; cov[2][1] = yz; cov[2][2] = zz;
+
+  jacobi(cov, v);
+
+  box->axis[0] = vec3fNormalize((vec3f){ v[0][0], v[1][0], v[2][0] });
+  box->axis[1] = vec3fNormalize((vec3f){ v[0][1], v[1][1], v[2][1] });
+  box->axis[2] = vec3fCross(box->axis[0], box->axis[1]);
+
+  for(j = 0; j < 3; ++j)
+  {
+    lo[j] =  INFINITY;
+    hi[j] = -INFINITY;
+  }
+
+  for(i = 0; i < count; ++i)
+  {
+    vec3f d = vec3fSubtract(points[i], mean);
+
+    for(j = 0; j < 3; ++j)
+    {
+      float proj = vec3fDot(d, box->axis[j]);
+
+      lo[j] = proj < lo[j] ? proj : lo[j];
+      hi[j] = proj > hi[j] ? proj : hi[j];
+    }
+  }
+
+  box->center = mean;
+  for(j = 0; j < 3; ++j)
+    box->center = vec3fAdd(box->center, vec3fScale(box->axis[j], (lo[j] + hi[j]) * 0.5f));
+
+  box->extent = (vec3f){ (hi[0] - lo[0]) * 0.5f,
+                         (hi[1] - lo[1]) * 0.5f,
+                         (hi[2] - lo[2]) * 0.5f };
+}
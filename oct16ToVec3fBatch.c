@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void oct16ToVec3fBatch(vec3f *out, const u16 *in, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+
+  for(i = 0; i < count; ++i)
+    out[i] = oct16ToVec3f(in[i]);
+}
@@ -0,0 +1,233 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#ifdef GS_MATH_PROFILE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef ARM11
+#include <pthread.h>
+#endif
+
+/* the last slot collects functions registered after the table filled up */
+#define OTHER (PROFILE_MAX_FUNCTIONS - 1)
+
+typedef struct profileThread
+{
+  u64                   calls[PROFILE_MAX_FUNCTIONS];
+  u64                   ticks[PROFILE_MAX_FUNCTIONS];
+  struct profileThread *next;
+} profileThread;
+
+static const char    *names[PROFILE_MAX_FUNCTIONS];
+static u32            nextIndex = 1;
+static profileThread *threads;  /* live threads' counters */
+static profileThread  retired;  /* counters of exited threads */
+static profileThread  baseline; /* totals at the last profileReset */
+
+#ifdef ARM11
+/* single-threaded: one set of counters, no locking */
+static profileThread counters;
+
+#define lock()   (void)0
+#define unlock() (void)0
+
+static inline profileThread*
+self(void)
+{
+  if(!threads)
+    threads = &counters;
+
+  return &counters;
+}
+#else
+static pthread_mutex_t  mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t   once  = PTHREAD_ONCE_INIT;
+static pthread_key_t    key;
+static __thread profileThread *current;
+
+#define lock()   pthread_mutex_lock(&mutex)
+#define unlock() pthread_mutex_unlock(&mutex)
+
+/* fold an exiting thread's counters into retired */
+static void
+detach(void *arg)
+{
+  profileThread *t = (profileThread*)arg, **p;
+  u32           i;
+
+  lock();
+
+  for(i = 0; i < PROFILE_MAX_FUNCTIONS; ++i)
+  {
+    retired.calls[i] += t->calls[i];
+    retired.ticks[i] += t->ticks[i];
+  }
+
+  for(p = &threads; *p; p = &(*p)->next)
+  {
+    if(*p == t)
+    {
+      *p = t->next;
+      break;
+    }
+  }
+
+  unlock();
+
+  /* profiled calls from later TLS destructors start a fresh set */
+  current = NULL;
+  free(t);
+}
+
+static void
+createKey(void)
+{
+  pthread_key_create(&key, detach);
+}
+
+static profileThread*
+attach(void)
+{
+  profileThread *t = (profileThread*)calloc(1, sizeof(*t));
+
+  if(!t)
+    abort();
+
+  pthread_once(&once, createKey);
+  pthread_setspecific(key, t);
+
+  lock();
+  t->next = threads;
+  threads = t;
+  unlock();
+
+  return current = t;
+}
+
+static inline profileThread*
+self(void)
+{
+  return current ? current : attach();
+}
+#endif
+
+u32 profileRegister(profileSite *site)
+{
+  u32 index;
+
+  lock();
+
+  index = site->index;
+  if(!index)
+  {
+    index = nextIndex < OTHER ? nextIndex++ : OTHER;
+    names[index] = index == OTHER ? "(other)" : site->name;
+    __atomic_store_n(&site->index, index, __ATOMIC_RELEASE);
+  }
+
+  unlock();
+
+  return index;
+}
+
+void profileRecord(u32 index, u64 ticks)
+{
+  profileThread *t = self();
+
+  /* only this thread writes these; snapshots read them concurrently */
+  __atomic_store_n(&t->calls[index], t->calls[index] + 1,     __ATOMIC_RELAXED);
+  __atomic_store_n(&t->ticks[index], t->ticks[index] + ticks, __ATOMIC_RELAXED);
+}
+
+/* totals since startup; caller holds the lock */
+static void
+total(u32 index, u64 *calls, u64 *ticks)
+{
+  const profileThread *t;
+
+  *calls = retired.calls[index];
+  *ticks = retired.ticks[index];
+
+  for(t = threads; t; t = t->next)
+  {
+    *calls += __atomic_load_n(&t->calls[index], __ATOMIC_RELAXED);
+    *ticks += __atomic_load_n(&t->ticks[index], __ATOMIC_RELAXED);
+  }
+}
+
+size_t profileSnapshot(profileEntry *out, size_t max)
+{
+  size_t count = 0;
+  u32    i;
+
+  lock();
+
+  for(i = 1; i < PROFILE_MAX_FUNCTIONS; ++i)
+  {
+    u64 calls, ticks;
+
+    if(!names[i])
+      continue;
+
+    if(count < max)
+    {
+      total(i, &calls, &ticks);
+
+      out[count].name  = names[i];
+      out[count].calls = calls - baseline.calls[i];
+      out[count].ticks = ticks - baseline.ticks[i];
+    }
+
+    ++count;
+  }
+
+  unlock();
+
+  return count;
+}
+
+void profileReset(void)
+{
+  u32 i;
+
+  lock();
+
+  for(i = 1; i < PROFILE_MAX_FUNCTIONS; ++i)
+    total(i, &baseline.calls[i], &baseline.ticks[i]);
+
+  unlock();
+}
+
+static int
+compareTicks(const void *lhs, const void *rhs)
+{
+  u64 a = ((const profileEntry*)lhs)->ticks;
+  u64 b = ((const profileEntry*)rhs)->ticks;
+
+  return a < b ? 1 : a > b ? -1 : 0;
+}
+
+void profileDump(FILE *fp)
+{
+  profileEntry entries[PROFILE_MAX_FUNCTIONS];
+  size_t       count = profileSnapshot(entries, PROFILE_MAX_FUNCTIONS);
+  size_t       i;
+
+  qsort(entries, count, sizeof(entries[0]), compareTicks);
+
+  fprintf(fp, "%12s %16s %12s  %s\n", "calls", "ticks", "ticks/call", "function");
+
+  for(i = 0; i < count; ++i)
+  {
+    if(entries[i].calls == 0)
+      continue;
+
+    fprintf(fp, "%12llu %16llu %12llu  %s\n",
+            (unsigned long long)entries[i].calls,
+            (unsigned long long)entries[i].ticks,
+            (unsigned long long)(entries[i].ticks / entries[i].calls),
+            entries[i].name);
+  }
+}
+#endif
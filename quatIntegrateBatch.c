@@ -0,0 +1,67 @@
+#include <float.h>
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+/* rounding growth of |q|^2 per step, with margin */
+#define STEP_DRIFT (8.0f * FLT_EPSILON)
+
+size_t quatIntegrateBatch(quatSoA q, vec3fSoA w, float *drift, float dt, float tolerance, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n, renormalized = 0;
+
+  for(n = 0; n < count; ++n)
+  {
+    float wx = w.x[n], wy = w.y[n], wz = w.z[n];
+    float len2 = wx*wx + wy*wy + wz*wz;
+    float h    = 0.5f * dt;
+    float h2   = h*h*len2; /* squared half-angle */
+    float c, s;
+    float qr = q.r[n], qi = q.i[n], qj = q.j[n], qk = q.k[n];
+
+    /* dq = (cos(a), sin(a) * w/|w|) with a = |w|*dt/2; s absorbs the
+     * 1/|w|, and small steps use the series so that w = 0 needs no special
+     * case
+     */
+    if(h2 < 0.25f)
+    {
+      c = 1.0f - h2/2.0f * (1.0f - h2/12.0f * (1.0f - h2/30.0f * (1.0f - h2/56.0f)));
+      s = h * (1.0f - h2/6.0f * (1.0f - h2/20.0f * (1.0f - h2/42.0f * (1.0f - h2/72.0f))));
+    }
+    else
+    {
+      float len = sqrtf(len2);
+      float a   = h*len;
+
+      c = cosf(a);
+      s = sinf(a) / len;
+    }
+
+    wx *= s;
+    wy *= s;
+    wz *= s;
+
+    q.r[n] = c*qr - wx*qi - wy*qj - wz*qk;
+    q.i[n] = c*qi + wx*qr + wy*qk - wz*qj;
+    q.j[n] = c*qj + wy*qr + wz*qi - wx*qk;
+    q.k[n] = c*qk + wz*qr + wx*qj - wy*qi;
+
+    drift[n] += STEP_DRIFT;
+
+    if(drift[n] > tolerance)
+    {
+      float inv = 1.0f / sqrtf(q.r[n]*q.r[n] + q.i[n]*q.i[n] + q.j[n]*q.j[n] + q.k[n]*q.k[n]);
+
+      q.r[n] *= inv;
+      q.i[n] *= inv;
+      q.j[n] *= inv;
+      q.k[n] *= inv;
+      drift[n] = 0.0f;
+      ++renormalized;
+    }
+  }
+
+  return renormalized;
+}
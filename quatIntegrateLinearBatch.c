@@ -0,0 +1,45 @@
+#include <float.h>
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+/* rounding growth of |q|^2 per step, with margin */
+#define STEP_DRIFT (8.0f * FLT_EPSILON)
+
+size_t quatIntegrateLinearBatch(quatSoA q, vec3fSoA w, float *drift, float dt, float tolerance, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n, renormalized = 0;
+  float  h = 0.5f * dt;
+
+  for(n = 0; n < count; ++n)
+  {
+    float wx = w.x[n]*h, wy = w.y[n]*h, wz = w.z[n]*h;
+    float qr = q.r[n], qi = q.i[n], qj = q.j[n], qk = q.k[n];
+
+    /* (0, w) * q is orthogonal to q, so |q|^2 grows by exactly |w*h|^2 */
+    float growth = wx*wx + wy*wy + wz*wz;
+
+    q.r[n] = qr - wx*qi - wy*qj - wz*qk;
+    q.i[n] = qi + wx*qr + wy*qk - wz*qj;
+    q.j[n] = qj + wy*qr + wz*qi - wx*qk;
+    q.k[n] = qk + wz*qr + wx*qj - wy*qi;
+
+    drift[n] = (1.0f + drift[n]) * (1.0f + growth) - 1.0f + STEP_DRIFT;
+
+    if(drift[n] > tolerance)
+    {
+      float inv = 1.0f / sqrtf(q.r[n]*q.r[n] + q.i[n]*q.i[n] + q.j[n]*q.j[n] + q.k[n]*q.k[n]);
+
+      q.r[n] *= inv;
+      q.i[n] *= inv;
+      q.j[n] *= inv;
+      q.k[n] *= inv;
+      drift[n] = 0.0f;
+      ++renormalized;
+    }
+  }
+
+  return renormalized;
+}
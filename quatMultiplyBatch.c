@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void quatMultiplyBatch(quat *out, const quat *lhs, const quat *rhs, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+
+  for(n = 0; n < count; ++n)
+    out[n] = quatMultiply(lhs[n], rhs[n]);
+}
@@ -0,0 +1,24 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+typedef struct
+{
+  quat       *out;
+  const quat *lhs;
+  const quat *rhs;
+} args;
+
+static void
+run(void *p, size_t first, size_t count)
+{
+  args *a = p;
+  quatMultiplyBatch(a->out + first, a->lhs + first, a->rhs + first, count);
+}
+
+void quatMultiplyBatchParallel(threadPool *pool, quat *out, const quat *lhs, const quat *rhs, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  args a = { out, lhs, rhs };
+  threadPoolFor(pool, count, sizeof(quat), run, &a);
+}
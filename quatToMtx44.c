@@ -1,7 +1,10 @@
 #include "gs_math.h"
+#include "gs_profile.h"
 
 void quatToMtx44(mtx44 *m, quat q)
 {
+  PROFILE_FUNCTION();
+
   float ii = q.i*q.i;
   float ij = q.i*q.j;
   float ik = q.i*q.k;
@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void quatToMtx44Batch(mtx44 *m, const quat *q, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+
+  for(n = 0; n < count; ++n)
+    quatToMtx44(&m[n], q[n]);
+}
@@ -0,0 +1,23 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+typedef struct
+{
+  mtx44      *m;
+  const quat *q;
+} args;
+
+static void
+run(void *p, size_t first, size_t count)
+{
+  args *a = p;
+  quatToMtx44Batch(a->m + first, a->q + first, count);
+}
+
+void quatToMtx44BatchParallel(threadPool *pool, mtx44 *m, const quat *q, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  args a = { m, q };
+  threadPoolFor(pool, count, sizeof(mtx44), run, &a);
+}
@@ -0,0 +1,16 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+unsigned ray4Aabb(const float t[4], const ray4 *r, const aabb *box)
+{
+  PROFILE_FUNCTION();
+
+  const v4f one = v4fSplat(1.0f);
+
+  v4f3 o   = { v4fLoad(r->ox), v4fLoad(r->oy), v4fLoad(r->oz) };
+  v4f3 inv = { one / v4fLoad(r->dx), one / v4fLoad(r->dy), one / v4fLoad(r->dz) };
+  v4f  tn  = v4fRayAabb(o, inv, v4f3Splat(box->min), v4f3Splat(box->max));
+
+  return v4iBits(tn < v4fLoad(t));
+}
@@ -0,0 +1,18 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+unsigned ray4Triangle(float t[4], const ray4 *r, vec3f v0, vec3f v1, vec3f v2)
+{
+  PROFILE_FUNCTION();
+
+  v4f3 o   = { v4fLoad(r->ox), v4fLoad(r->oy), v4fLoad(r->oz) };
+  v4f3 d   = { v4fLoad(r->dx), v4fLoad(r->dy), v4fLoad(r->dz) };
+  v4f  old = v4fLoad(t);
+  v4f  ht  = v4fRayTriangle(o, d, v4f3Splat(v0), v4f3Splat(v1), v4f3Splat(v2));
+  v4i  hit = ht < old;
+
+  v4fStore(t, v4fSelect(hit, ht, old));
+
+  return v4iBits(hit);
+}
@@ -0,0 +1,27 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+unsigned ray8Aabb(const float t[8], const ray8 *r, const aabb *box)
+{
+  PROFILE_FUNCTION();
+
+  const v4f one = v4fSplat(1.0f);
+
+  v4f3     min  = v4f3Splat(box->min);
+  v4f3     max  = v4f3Splat(box->max);
+  unsigned mask = 0;
+  int      h;
+
+  /* two 4-lane halves */
+  for(h = 0; h < 8; h += 4)
+  {
+    v4f3 o   = { v4fLoad(r->ox + h), v4fLoad(r->oy + h), v4fLoad(r->oz + h) };
+    v4f3 inv = { one / v4fLoad(r->dx + h), one / v4fLoad(r->dy + h), one / v4fLoad(r->dz + h) };
+    v4f  tn  = v4fRayAabb(o, inv, min, max);
+
+    mask |= v4iBits(tn < v4fLoad(t + h)) << h;
+  }
+
+  return mask;
+}
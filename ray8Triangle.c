@@ -0,0 +1,29 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+unsigned ray8Triangle(float t[8], const ray8 *r, vec3f v0, vec3f v1, vec3f v2)
+{
+  PROFILE_FUNCTION();
+
+  v4f3     a    = v4f3Splat(v0);
+  v4f3     b    = v4f3Splat(v1);
+  v4f3     c    = v4f3Splat(v2);
+  unsigned mask = 0;
+  int      h;
+
+  /* two 4-lane halves */
+  for(h = 0; h < 8; h += 4)
+  {
+    v4f3 o   = { v4fLoad(r->ox + h), v4fLoad(r->oy + h), v4fLoad(r->oz + h) };
+    v4f3 d   = { v4fLoad(r->dx + h), v4fLoad(r->dy + h), v4fLoad(r->dz + h) };
+    v4f  old = v4fLoad(t + h);
+    v4f  ht  = v4fRayTriangle(o, d, a, b, c);
+    v4i  hit = ht < old;
+
+    v4fStore(t + h, v4fSelect(hit, ht, old));
+    mask |= v4iBits(hit) << h;
+  }
+
+  return mask;
+}
@@ -0,0 +1,38 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int rayAabb(const ray *r, const aabb *box, float *near, float *far)
+{
+  PROFILE_FUNCTION();
+
+  const float *o  = &r->origin.x;
+  const float *d  = &r->direction.x;
+  const float *lo = &box->min.x;
+  const float *hi = &box->max.x;
+  float       tn  = 0.0f;
+  float       tf  = INFINITY;
+  int         i;
+
+  for(i = 0; i < 3; ++i)
+  {
+    float inv = 1.0f / d[i];
+    float t1  = (lo[i] - o[i]) * inv;
+    float t2  = (hi[i] - o[i]) * inv;
+    float a   = t1 < t2 ? t1 : t2;
+    float b   = t1 < t2 ? t2 : t1;
+
+    tn = a > tn ? a : tn;
+    tf = b < tf ? b : tf;
+  }
+
+  if(tn > tf)
+    return 0;
+
+  if(near)
+    *near = tn;
+  if(far)
+    *far = tf;
+
+  return 1;
+}
@@ -0,0 +1,31 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void rayAabbBatch(float *t, const ray *r, const aabb *boxes, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  vec3f  inv = { 1.0f / r->direction.x, 1.0f / r->direction.y, 1.0f / r->direction.z };
+  v4f3   o   = v4f3Splat(r->origin);
+  v4f3   i   = v4f3Splat(inv);
+  size_t n;
+  int    k;
+
+  /* four boxes per iteration, filled lane by lane as in rayTriangleBatch */
+  for(n = 0; n < count; n += 4)
+  {
+    size_t lanes = count - n < 4 ? count - n : 4;
+    v4f3   min, max;
+
+    for(k = 0; k < 4; ++k)
+    {
+      const aabb *b = &boxes[n + ((size_t)k < lanes ? (size_t)k : 0)];
+
+      v4f3Insert(&min, k, b->min);
+      v4f3Insert(&max, k, b->max);
+    }
+
+    v4fStoreN(t + n, v4fRayAabb(o, i, min, max), lanes);
+  }
+}
@@ -0,0 +1,42 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int rayTriangle(const ray *r, vec3f v0, vec3f v1, vec3f v2, float *t, float *u, float *v)
+{
+  PROFILE_FUNCTION();
+
+  vec3f e1 = vec3fSubtract(v1, v0);
+  vec3f e2 = vec3fSubtract(v2, v0);
+  vec3f p  = vec3fCross(r->direction, e2);
+  float det = vec3fDot(e1, p);
+  float inv, hu, hv, ht;
+  vec3f s, q;
+
+  if(fabsf(det) < 1e-12f)
+    return 0;
+
+  inv = 1.0f / det;
+  s   = vec3fSubtract(r->origin, v0);
+  hu  = vec3fDot(s, p) * inv;
+  if(hu < 0.0f || hu > 1.0f)
+    return 0;
+
+  q  = vec3fCross(s, e1);
+  hv = vec3fDot(r->direction, q) * inv;
+  if(hv < 0.0f || hu + hv > 1.0f)
+    return 0;
+
+  ht = vec3fDot(e2, q) * inv;
+  if(ht < 0.0f)
+    return 0;
+
+  if(t)
+    *t = ht;
+  if(u)
+    *u = hu;
+  if(v)
+    *v = hv;
+
+  return 1;
+}
@@ -0,0 +1,33 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void rayTriangleBatch(float *t, const ray *r, const vec3f *vertices, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  v4f3   o = v4f3Splat(r->origin);
+  v4f3   d = v4f3Splat(r->direction);
+  size_t n;
+  int    k;
+
+  /* four triangles per iteration; the vertices are AoS, so each lane is
+   * filled separately (a partial tail repeats the first triangle)
+   */
+  for(n = 0; n < count; n += 4)
+  {
+    size_t lanes = count - n < 4 ? count - n : 4;
+    v4f3   v0, v1, v2;
+
+    for(k = 0; k < 4; ++k)
+    {
+      const vec3f *v = &vertices[(n + ((size_t)k < lanes ? (size_t)k : 0)) * 3];
+
+      v4f3Insert(&v0, k, v[0]);
+      v4f3Insert(&v1, k, v[1]);
+      v4f3Insert(&v2, k, v[2]);
+    }
+
+    v4fStoreN(t + n, v4fRayTriangle(o, d, v0, v1, v2), lanes);
+  }
+}
@@ -0,0 +1,13 @@
+#include <stdlib.h>
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void rotationCacheFree(rotationCache *c)
+{
+  PROFILE_FUNCTION();
+
+  free(c->table);
+
+  memset(c, 0, sizeof(*c));
+}
@@ -0,0 +1,36 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int rotationCacheInit(rotationCache *c, u32 steps)
+{
+  PROFILE_FUNCTION();
+
+  u32 k;
+
+  memset(c, 0, sizeof(*c));
+
+  if(!steps)
+    return 0;
+
+  /* half-step resolution serves both matrices (full angle) and quaternions
+   * (half angle) from one table
+   */
+  c->table = (float*)malloc(4 * (size_t)steps * sizeof(float));
+  if(!c->table)
+    return 0;
+
+  c->steps = steps;
+
+  for(k = 0; k < 2 * steps; ++k)
+  {
+    double a = M_PI * k / steps;
+
+    c->table[2*k+0] = (float)sin(a);
+    c->table[2*k+1] = (float)cos(a);
+  }
+
+  return 1;
+}
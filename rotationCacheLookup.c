@@ -0,0 +1,54 @@
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+const float* rotationCacheLookup(rotationCache *c, vec3f axis, u32 step)
+{
+  PROFILE_FUNCTION();
+
+  rotationCacheAxis *e, *lru = &c->axes[0];
+  const float       *sc;
+  vec3f             n;
+  float             s, co, t;
+  int               i;
+
+  step %= c->steps;
+
+  for(i = 0; i < ROTATION_CACHE_AXES; ++i)
+  {
+    e = &c->axes[i];
+
+    if(e->used && e->step == step && memcmp(&e->axis, &axis, sizeof(axis)) == 0)
+    {
+      e->used = ++c->clock;
+      return &e->m[0][0];
+    }
+
+    if(e->used < lru->used)
+      lru = e;
+  }
+
+  sc = rotationCacheSinCos(c, 2 * step);
+  s  = sc[0];
+  co = sc[1];
+  t  = 1 - co;
+  n  = vec3fNormalize(axis);
+
+  lru->m[0][0] = t*n.x*n.x + co;
+  lru->m[0][1] = t*n.x*n.y + s*n.z;
+  lru->m[0][2] = t*n.x*n.z - s*n.y;
+
+  lru->m[1][0] = t*n.y*n.x - s*n.z;
+  lru->m[1][1] = t*n.y*n.y + co;
+  lru->m[1][2] = t*n.y*n.z + s*n.x;
+
+  lru->m[2][0] = t*n.z*n.x + s*n.y;
+  lru->m[2][1] = t*n.z*n.y - s*n.x;
+  lru->m[2][2] = t*n.z*n.z + co;
+
+  lru->axis = axis;
+  lru->step = step;
+  lru->used = ++c->clock;
+
+  return &lru->m[0][0];
+}
@@ -0,0 +1,15 @@
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void skeletonFree(skeleton *s)
+{
+  PROFILE_FUNCTION();
+
+  free(s->parents);
+  free(s->inverseBind);
+
+  s->parents     = NULL;
+  s->inverseBind = NULL;
+  s->count       = 0;
+}
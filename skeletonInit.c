@@ -0,0 +1,42 @@
+#include <stdlib.h>
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int skeletonInit(skeleton *s, const s32 *parents, const mtx44 *inverseBind, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+
+  s->parents     = NULL;
+  s->inverseBind = NULL;
+  s->count       = 0;
+
+  if(count && (!parents || !inverseBind))
+    return 0;
+
+  /* one forward pass builds every world matrix only if parents come first */
+  for(i = 0; i < count; ++i)
+  {
+    if(parents[i] >= (s32)i || parents[i] < -1)
+      return 0;
+  }
+
+  if(!count)
+    return 1;
+
+  s->parents     = (s32*)malloc(count * sizeof(s32));
+  s->inverseBind = (mtx44*)malloc(count * sizeof(mtx44));
+  if(!s->parents || !s->inverseBind)
+  {
+    skeletonFree(s);
+    return 0;
+  }
+
+  memcpy(s->parents, parents, count * sizeof(s32));
+  memcpy(s->inverseBind, inverseBind, count * sizeof(mtx44));
+  s->count = count;
+
+  return 1;
+}
@@ -0,0 +1,26 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void skeletonPalette(const skeleton *s, const boneTransform *pose, mtx44 *world, mtx44 *palette)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+
+  for(i = 0; i < s->count; ++i)
+  {
+    s32 parent = s->parents[i];
+
+    if(parent < 0)
+      boneTransformToMtx44(&world[i], &pose[i]);
+    else
+    {
+      mtx44 local;
+
+      boneTransformToMtx44(&local, &pose[i]);
+      mtx44MultiplyAffine(&world[i], &world[parent], &local);
+    }
+
+    mtx44MultiplyAffine(&palette[i], &world[i], &s->inverseBind[i]);
+  }
+}
@@ -0,0 +1,29 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void skeletonPaletteAffine(const skeleton *s, const boneTransform *pose, mtx44 *world, vec4f *palette)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+  int    j;
+
+  for(i = 0; i < s->count; ++i, palette += 3)
+  {
+    s32   parent = s->parents[i];
+    mtx44 m;
+
+    if(parent < 0)
+      boneTransformToMtx44(&world[i], &pose[i]);
+    else
+    {
+      boneTransformToMtx44(&m, &pose[i]);
+      mtx44MultiplyAffine(&world[i], &world[parent], &m);
+    }
+
+    mtx44MultiplyAffine(&m, &world[i], &s->inverseBind[i]);
+
+    for(j = 0; j < 3; ++j)
+      palette[j] = (vec4f){ m.v[0*4+j], m.v[1*4+j], m.v[2*4+j], m.v[3*4+j] };
+  }
+}
@@ -0,0 +1,16 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void skeletonPaletteBatch(const skeleton *s, const boneTransform *pose, mtx44 *world, mtx44 *palette, size_t instances)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+
+  for(n = 0; n < instances; ++n)
+  {
+    size_t first = n * s->count;
+
+    skeletonPalette(s, pose + first, world + first, palette + first);
+  }
+}
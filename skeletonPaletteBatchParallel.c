@@ -0,0 +1,27 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+typedef struct
+{
+  const skeleton      *s;
+  const boneTransform *pose;
+  mtx44               *world;
+  mtx44               *palette;
+} args;
+
+static void
+run(void *p, size_t first, size_t count)
+{
+  args  *a     = p;
+  size_t bones = a->s->count;
+
+  skeletonPaletteBatch(a->s, a->pose + first*bones, a->world + first*bones, a->palette + first*bones, count);
+}
+
+void skeletonPaletteBatchParallel(threadPool *pool, const skeleton *s, const boneTransform *pose, mtx44 *world, mtx44 *palette, size_t instances)
+{
+  PROFILE_FUNCTION();
+
+  args a = { s, pose, world, palette };
+  threadPoolFor(pool, instances, s->count * sizeof(mtx44), run, &a);
+}
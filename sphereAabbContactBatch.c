@@ -0,0 +1,56 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+size_t sphereAabbContactBatch(contactSoA out, sphereSoA a, aabbSoA b, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  const v4f zero = v4fSplat(0.0f), one = v4fSplat(1.0f), half = v4fSplat(0.5f);
+
+  size_t n, k, touching = 0;
+
+  for(n = 0; n < count; n += 4)
+  {
+    size_t lanes = count - n < 4 ? count - n : 4;
+
+    v4f3 c   = v4f3LoadN(a.center, n, lanes);
+    v4f  r   = v4fLoadN(a.radius + n, lanes);
+    v4f3 min = v4f3LoadN(b.min, n, lanes);
+    v4f3 max = v4f3LoadN(b.max, n, lanes);
+
+    /* outside: the closest point of the box is on its surface */
+    v4f3 q       = { v4fClamp(c.x, min.x, max.x), v4fClamp(c.y, min.y, max.y), v4fClamp(c.z, min.z, max.z) };
+    v4f3 d       = v4f3Subtract(q, c);
+    v4f  dist    = v4fSqrt(v4f3Dot(d, d));
+    v4i  outside = dist > zero;
+    v4f3 nOut    = v4f3Scale(d, one / v4fSelect(outside, dist, one));
+    v4f  dOut    = r - dist;
+    v4f3 pOut    = v4f3Scale(v4f3Add(v4f3Add(c, v4f3Scale(nOut, r)), q), half);
+
+    /* inside: leave through the nearest face; the normal points into it */
+    v4f  face = c.x - min.x;
+    v4f3 nIn  = { one, zero, zero };
+    v4f  e;
+    v4i  m;
+
+    e = max.x - c.x; m = e < face; face = v4fSelect(m, e, face); nIn = v4f3Select(m, (v4f3){ -one, zero, zero }, nIn);
+    e = c.y - min.y; m = e < face; face = v4fSelect(m, e, face); nIn = v4f3Select(m, (v4f3){ zero,  one, zero }, nIn);
+    e = max.y - c.y; m = e < face; face = v4fSelect(m, e, face); nIn = v4f3Select(m, (v4f3){ zero, -one, zero }, nIn);
+    e = c.z - min.z; m = e < face; face = v4fSelect(m, e, face); nIn = v4f3Select(m, (v4f3){ zero, zero,  one }, nIn);
+    e = max.z - c.z; m = e < face; face = v4fSelect(m, e, face); nIn = v4f3Select(m, (v4f3){ zero, zero, -one }, nIn);
+
+    v4f3 normal = v4f3Select(outside, nOut, nIn);
+    v4f  depth  = v4fSelect(outside, dOut, r + face);
+    v4f3 point  = v4f3Select(outside, pOut, v4f3Subtract(c, v4f3Scale(nIn, (face - r) * half)));
+
+    v4f3StoreN(out.normal, n, normal, lanes);
+    v4f3StoreN(out.point, n, point, lanes);
+    v4fStoreN(out.depth + n, depth, lanes);
+
+    for(k = 0; k < lanes; ++k)
+      touching += depth[k] >= 0.0f;
+  }
+
+  return touching;
+}
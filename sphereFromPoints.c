@@ -0,0 +1,65 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+static size_t
+farthest(const vec3f *points, size_t count, vec3f from)
+{
+  size_t i, best = 0;
+  float  bestDist = -1.0f;
+
+  for(i = 0; i < count; ++i)
+  {
+    vec3f d    = vec3fSubtract(points[i], from);
+    float dist = vec3fDot(d, d);
+
+    if(dist > bestDist)
+    {
+      bestDist = dist;
+      best     = i;
+    }
+  }
+
+  return best;
+}
+
+void sphereFromPoints(sphere *s, const vec3f *points, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  vec3f  a, b, c;
+  float  r;
+  size_t i;
+
+  if(count == 0)
+  {
+    s->center = (vec3f){ 0.0f, 0.0f, 0.0f };
+    s->radius = -1.0f;
+    return;
+  }
+
+  /* initial guess from an approximately diametric pair */
+  a = points[farthest(points, count, points[0])];
+  b = points[farthest(points, count, a)];
+  c = vec3fScale(vec3fAdd(a, b), 0.5f);
+  r = sqrtf(vec3fDot(vec3fSubtract(b, a), vec3fSubtract(b, a))) * 0.5f;
+
+  /* grow to enclose any points left outside */
+  for(i = 0; i < count; ++i)
+  {
+    vec3f d    = vec3fSubtract(points[i], c);
+    float dist = vec3fDot(d, d);
+
+    if(dist > r*r)
+    {
+      float len  = sqrtf(dist);
+      float newR = (r + len) * 0.5f;
+
+      c = vec3fAdd(c, vec3fScale(d, (newR - r) / len));
+      r = newR;
+    }
+  }
+
+  s->center = c;
+  s->radius = r;
+}
@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void sphereFromPointsBatch(sphere *spheres, const vec3f *points, const size_t *offsets, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+
+  for(i = 0; i < count; ++i)
+    sphereFromPoints(&spheres[i], points + offsets[i], offsets[i+1] - offsets[i]);
+}
@@ -0,0 +1,30 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+size_t sphereSphereContactBatch(contactSoA out, sphereSoA a, sphereSoA b, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n, k, touching = 0;
+
+  for(n = 0; n < count; n += 4)
+  {
+    size_t lanes = count - n < 4 ? count - n : 4;
+    v4f3   normal, point;
+    v4f    depth;
+
+    depth = v4fSphereContact(&normal, &point,
+                             v4f3LoadN(a.center, n, lanes), v4fLoadN(a.radius + n, lanes),
+                             v4f3LoadN(b.center, n, lanes), v4fLoadN(b.radius + n, lanes));
+
+    v4f3StoreN(out.normal, n, normal, lanes);
+    v4f3StoreN(out.point, n, point, lanes);
+    v4fStoreN(out.depth + n, depth, lanes);
+
+    for(k = 0; k < lanes; ++k)
+      touching += depth[k] >= 0.0f;
+  }
+
+  return touching;
+}
@@ -0,0 +1,345 @@
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#ifndef ARM11
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define CACHE_LINE 64
+
+/* a worker's remaining chunks [begin, end), packed as begin | end << 32 so
+ * that the owner (taking from the front) and thieves (taking from the back)
+ * can race with a single compare-and-swap
+ */
+typedef struct
+{
+  _Atomic u64 range;
+  char        pad[CACHE_LINE - sizeof(u64)];
+} worker;
+
+struct threadPool
+{
+  pthread_t       *threads;
+  worker          *workers;
+  unsigned         count;
+  pthread_mutex_t  mutex;
+  pthread_cond_t   wake;
+  pthread_cond_t   done;
+  unsigned         generation;
+  unsigned         active;
+  int              quit;
+
+  threadPoolFunc   fn;
+  void            *arg;
+  size_t           total;
+  size_t           chunk;
+};
+
+typedef struct
+{
+  threadPool *pool;
+  unsigned    index;
+} startInfo;
+
+static inline u64
+pack(u32 begin, u32 end)
+{
+  return (u64)begin | (u64)end << 32;
+}
+
+static int
+takeFront(worker *w, u32 *chunk)
+{
+  u64 r = atomic_load(&w->range);
+
+  while((u32)r < (u32)(r >> 32))
+  {
+    if(atomic_compare_exchange_weak(&w->range, &r, r + 1))
+    {
+      *chunk = (u32)r;
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static int
+stealHalf(worker *victim, u32 *begin, u32 *end)
+{
+  u64 r = atomic_load(&victim->range);
+
+  while((u32)r < (u32)(r >> 32))
+  {
+    u32 b = (u32)r, e = (u32)(r >> 32);
+    u32 m = b + (e - b) / 2;
+
+    if(atomic_compare_exchange_weak(&victim->range, &r, pack(b, m)))
+    {
+      *begin = m;
+      *end   = e;
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static void
+execute(threadPool *pool, u32 chunk)
+{
+  size_t first = (size_t)chunk * pool->chunk;
+  size_t count = pool->total - first < pool->chunk ? pool->total - first : pool->chunk;
+
+  pool->fn(pool->arg, first, count);
+}
+
+static void
+work(threadPool *pool, unsigned self)
+{
+  worker  *w = &pool->workers[self];
+  u32      chunk, begin = 0, end = 0;
+  unsigned i;
+  int      stolen;
+
+  for(;;)
+  {
+    while(takeFront(w, &chunk))
+      execute(pool, chunk);
+
+    /* out of work; steal half of someone else's remaining chunks */
+    stolen = 0;
+    for(i = 1; i < pool->count && !stolen; ++i)
+      stolen = stealHalf(&pool->workers[(self + i) % pool->count], &begin, &end);
+
+    if(!stolen)
+      return;
+
+    /* our range is empty, so nobody can be racing to take from it */
+    atomic_store(&w->range, pack(begin + 1, end));
+    execute(pool, begin);
+  }
+}
+
+static void*
+threadMain(void *p)
+{
+  startInfo   info = *(startInfo*)p;
+  threadPool *pool = info.pool;
+  unsigned    seen = 0;
+
+  free(p);
+
+  pthread_mutex_lock(&pool->mutex);
+  for(;;)
+  {
+    while(pool->generation == seen && !pool->quit)
+      pthread_cond_wait(&pool->wake, &pool->mutex);
+
+    if(pool->quit)
+      break;
+
+    seen = pool->generation;
+    pthread_mutex_unlock(&pool->mutex);
+
+    work(pool, info.index);
+
+    pthread_mutex_lock(&pool->mutex);
+    if(--pool->active == 0)
+      pthread_cond_signal(&pool->done);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+
+  return NULL;
+}
+
+threadPool* threadPoolCreate(unsigned threads)
+{
+  PROFILE_FUNCTION();
+
+  threadPool *pool;
+  unsigned    i;
+
+  if(threads == 0)
+  {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = n > 0 ? (unsigned)n : 1;
+  }
+
+  pool = calloc(1, sizeof(threadPool));
+  if(!pool)
+    return NULL;
+
+  pool->count = threads;
+  if(posix_memalign((void**)&pool->workers, CACHE_LINE, threads * sizeof(worker)) != 0)
+  {
+    free(pool);
+    return NULL;
+  }
+
+  pool->threads = calloc(threads, sizeof(pthread_t));
+  if(!pool->threads)
+  {
+    free(pool->workers);
+    free(pool);
+    return NULL;
+  }
+
+  for(i = 0; i < threads; ++i)
+    atomic_init(&pool->workers[i].range, 0);
+
+  pthread_mutex_init(&pool->mutex, NULL);
+  pthread_cond_init(&pool->wake, NULL);
+  pthread_cond_init(&pool->done, NULL);
+
+  /* the calling thread acts as worker 0 */
+  for(i = 1; i < threads; ++i)
+  {
+    startInfo *info = malloc(sizeof(startInfo));
+
+    if(info)
+    {
+      info->pool  = pool;
+      info->index = i;
+    }
+
+    if(!info || pthread_create(&pool->threads[i], NULL, threadMain, info) != 0)
+    {
+      free(info);
+      pool->count = i;
+      threadPoolDestroy(pool);
+      return NULL;
+    }
+  }
+
+  return pool;
+}
+
+void threadPoolDestroy(threadPool *pool)
+{
+  PROFILE_FUNCTION();
+
+  unsigned i;
+
+  if(!pool)
+    return;
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->quit = 1;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->mutex);
+
+  for(i = 1; i < pool->count; ++i)
+    pthread_join(pool->threads[i], NULL);
+
+  pthread_cond_destroy(&pool->done);
+  pthread_cond_destroy(&pool->wake);
+  pthread_mutex_destroy(&pool->mutex);
+
+  free(pool->threads);
+  free(pool->workers);
+  free(pool);
+}
+
+unsigned threadPoolSize(const threadPool *pool)
+{
+  PROFILE_FUNCTION();
+
+  return pool ? pool->count : 1;
+}
+
+void threadPoolFor(threadPool *pool, size_t count, size_t size, threadPoolFunc fn, void *arg)
+{
+  PROFILE_FUNCTION();
+
+  size_t   align, chunk, chunks;
+  unsigned i;
+
+  if(!pool || pool->count < 2 || count == 0)
+  {
+    if(count)
+      fn(arg, 0, count);
+    return;
+  }
+
+  /* about eight chunks per worker for balance, rounded so that every chunk
+   * covers whole cache lines of the output
+   */
+  align = 1;
+  while((align * size) % CACHE_LINE != 0 && align < CACHE_LINE)
+    align *= 2;
+
+  chunk = count / (pool->count * 8);
+  chunk = (chunk + align - 1) / align * align;
+  if(chunk == 0)
+    chunk = align;
+
+  chunks = (count + chunk - 1) / chunk;
+  if(chunks < 2)
+  {
+    fn(arg, 0, count);
+    return;
+  }
+
+  pthread_mutex_lock(&pool->mutex);
+
+  pool->fn    = fn;
+  pool->arg   = arg;
+  pool->total = count;
+  pool->chunk = chunk;
+
+  for(i = 0; i < pool->count; ++i)
+  {
+    u32 begin = (u32)(chunks * i / pool->count);
+    u32 end   = (u32)(chunks * (i+1) / pool->count);
+    atomic_store(&pool->workers[i].range, pack(begin, end));
+  }
+
+  pool->active = pool->count;
+  ++pool->generation;
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->mutex);
+
+  work(pool, 0);
+
+  pthread_mutex_lock(&pool->mutex);
+  --pool->active;
+  while(pool->active != 0)
+    pthread_cond_wait(&pool->done, &pool->mutex);
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+#else
+
+/* no worker threads on the 3DS; everything runs on the calling thread */
+
+threadPool* threadPoolCreate(unsigned threads)
+{
+  PROFILE_FUNCTION();
+
+  return NULL;
+}
+
+void threadPoolDestroy(threadPool *pool)
+{
+  PROFILE_FUNCTION();
+}
+
+unsigned threadPoolSize(const threadPool *pool)
+{
+  PROFILE_FUNCTION();
+
+  return 1;
+}
+
+void threadPoolFor(threadPool *pool, size_t count, size_t size, threadPoolFunc fn, void *arg)
+{
+  PROFILE_FUNCTION();
+
+  if(count)
+    fn(arg, 0, count);
+}
+
+#endif
@@ -0,0 +1,20 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#define FRESH 4
+
+const void* tripleBufferAcquire(tripleBuffer *tb, u64 *frame)
+{
+  PROFILE_FUNCTION();
+
+  if(__atomic_load_n(&tb->state, __ATOMIC_RELAXED) & FRESH)
+  {
+    u32 prev = __atomic_exchange_n(&tb->state, tb->read, __ATOMIC_ACQ_REL);
+    tb->read = prev & 3;
+  }
+
+  if(frame)
+    *frame = tb->frame[tb->read];
+
+  return tb->buffer[tb->read];
+}
@@ -0,0 +1,16 @@
+#include <stdlib.h>
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void tripleBufferFree(tripleBuffer *tb)
+{
+  PROFILE_FUNCTION();
+
+  int i;
+
+  for(i = 0; i < 3; ++i)
+    free(tb->buffer[i]);
+
+  memset(tb, 0, sizeof(*tb));
+}
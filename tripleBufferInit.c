@@ -0,0 +1,35 @@
+#include <stdlib.h>
+#include <string.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int tripleBufferInit(tripleBuffer *tb, size_t size)
+{
+  PROFILE_FUNCTION();
+
+  int i;
+
+  size = (size + 63) & ~(size_t)63;
+
+  memset(tb, 0, sizeof(*tb));
+  tb->size = size;
+
+  for(i = 0; i < 3; ++i)
+  {
+    if(posix_memalign(&tb->buffer[i], 64, size ? size : 64) != 0)
+    {
+      tb->buffer[i] = NULL;
+      tripleBufferFree(tb);
+      return 0;
+    }
+
+    memset(tb->buffer[i], 0, size);
+  }
+
+  /* writer starts with 0, the shared slot holds 1 and the reader 2 */
+  tb->write = 0;
+  tb->state = 1;
+  tb->read  = 2;
+
+  return 1;
+}
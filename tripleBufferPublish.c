@@ -0,0 +1,20 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+#define FRESH 4
+
+u64 tripleBufferPublish(tripleBuffer *tb)
+{
+  PROFILE_FUNCTION();
+
+  u32 prev;
+
+  tb->frame[tb->write] = ++tb->published;
+
+  /* release makes the buffer's contents visible to whoever acquires it */
+  prev = __atomic_exchange_n(&tb->state, tb->write | FRESH, __ATOMIC_ACQ_REL);
+
+  tb->write = prev & 3;
+
+  return tb->published;
+}
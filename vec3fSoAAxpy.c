@@ -0,0 +1,25 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void vec3fSoAAxpy(vec3fSoA y, float a, vec3fSoA x, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  v4f    va = v4fSplat(a);
+  size_t n;
+
+  for(n = 0; n + 4 <= count; n += 4)
+  {
+    v4fStore(y.x + n, v4fLoad(y.x + n) + va*v4fLoad(x.x + n));
+    v4fStore(y.y + n, v4fLoad(y.y + n) + va*v4fLoad(x.y + n));
+    v4fStore(y.z + n, v4fLoad(y.z + n) + va*v4fLoad(x.z + n));
+  }
+
+  for(; n < count; ++n)
+  {
+    y.x[n] += a*x.x[n];
+    y.y[n] += a*x.y[n];
+    y.z[n] += a*x.z[n];
+  }
+}
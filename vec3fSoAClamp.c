@@ -0,0 +1,30 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void vec3fSoAClamp(vec3fSoA v, vec3f min, vec3f max, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  v4f    minx = v4fSplat(min.x), miny = v4fSplat(min.y), minz = v4fSplat(min.z);
+  v4f    maxx = v4fSplat(max.x), maxy = v4fSplat(max.y), maxz = v4fSplat(max.z);
+  size_t n;
+
+  for(n = 0; n + 4 <= count; n += 4)
+  {
+    v4fStore(v.x + n, v4fMin(v4fMax(v4fLoad(v.x + n), minx), maxx));
+    v4fStore(v.y + n, v4fMin(v4fMax(v4fLoad(v.y + n), miny), maxy));
+    v4fStore(v.z + n, v4fMin(v4fMax(v4fLoad(v.z + n), minz), maxz));
+  }
+
+  for(; n < count; ++n)
+  {
+    v.x[n] = v.x[n] > min.x ? v.x[n] : min.x;
+    v.y[n] = v.y[n] > min.y ? v.y[n] : min.y;
+    v.z[n] = v.z[n] > min.z ? v.z[n] : min.z;
+
+    v.x[n] = v.x[n] < max.x ? v.x[n] : max.x;
+    v.y[n] = v.y[n] < max.y ? v.y[n] : max.y;
+    v.z[n] = v.z[n] < max.z ? v.z[n] : max.z;
+  }
+}
@@ -0,0 +1,21 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+size_t vec3fSoACompact(vec3fSoA v, const u8 *alive, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n, kept = 0;
+
+  /* branch-free: always copy, only advance past live elements */
+  for(n = 0; n < count; ++n)
+  {
+    v.x[kept] = v.x[n];
+    v.y[kept] = v.y[n];
+    v.z[kept] = v.z[n];
+
+    kept += alive[n] != 0;
+  }
+
+  return kept;
+}
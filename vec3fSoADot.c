@@ -0,0 +1,20 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void vec3fSoADot(float *out, vec3fSoA a, vec3fSoA b, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+
+  for(n = 0; n + 4 <= count; n += 4)
+  {
+    v4fStore(out + n, v4fLoad(a.x + n)*v4fLoad(b.x + n)
+                    + v4fLoad(a.y + n)*v4fLoad(b.y + n)
+                    + v4fLoad(a.z + n)*v4fLoad(b.z + n));
+  }
+
+  for(; n < count; ++n)
+    out[n] = a.x[n]*b.x[n] + a.y[n]*b.y[n] + a.z[n]*b.z[n];
+}
@@ -0,0 +1,24 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void vec3fSoAFma(vec3fSoA out, vec3fSoA a, vec3fSoA b, vec3fSoA c, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+
+  for(n = 0; n + 4 <= count; n += 4)
+  {
+    v4fStore(out.x + n, v4fLoad(a.x + n)*v4fLoad(b.x + n) + v4fLoad(c.x + n));
+    v4fStore(out.y + n, v4fLoad(a.y + n)*v4fLoad(b.y + n) + v4fLoad(c.y + n));
+    v4fStore(out.z + n, v4fLoad(a.z + n)*v4fLoad(b.z + n) + v4fLoad(c.z + n));
+  }
+
+  for(; n < count; ++n)
+  {
+    out.x[n] = a.x[n]*b.x[n] + c.x[n];
+    out.y[n] = a.y[n]*b.y[n] + c.y[n];
+    out.z[n] = a.z[n]*b.z[n] + c.z[n];
+  }
+}
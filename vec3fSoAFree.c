@@ -0,0 +1,14 @@
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void vec3fSoAFree(vec3fSoA *v)
+{
+  PROFILE_FUNCTION();
+
+  free(v->x);
+
+  v->x = NULL;
+  v->y = NULL;
+  v->z = NULL;
+}
@@ -0,0 +1,23 @@
+#include <stdlib.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+int vec3fSoAInit(vec3fSoA *v, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  void  *base = NULL;
+  size_t stride;
+
+  /* pad each array to whole cache lines so all three stay 64-byte aligned */
+  stride = (count + 15) & ~(size_t)15;
+
+  if(stride && posix_memalign(&base, 64, 3 * stride * sizeof(float)) != 0)
+    base = NULL;
+
+  v->x = (float*)base;
+  v->y = base ? v->x + stride : NULL;
+  v->z = base ? v->y + stride : NULL;
+
+  return base != NULL || stride == 0;
+}
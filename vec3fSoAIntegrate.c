@@ -0,0 +1,43 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void vec3fSoAIntegrate(vec3fSoA p, vec3fSoA v, vec3f accel, float damping, float dt, const u8 *alive, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  static const u8 all[4] = { 1, 1, 1, 1 };
+
+  v4f    ax = v4fSplat(accel.x*dt), ay = v4fSplat(accel.y*dt), az = v4fSplat(accel.z*dt);
+  v4f    vd = v4fSplat(damping), vdt = v4fSplat(dt);
+  size_t n;
+
+  for(n = 0; n + 4 <= count; n += 4)
+  {
+    v4i m  = v4iMask(alive ? alive + n : all);
+    v4f vx = v4fLoad(v.x + n), vy = v4fLoad(v.y + n), vz = v4fLoad(v.z + n);
+    v4f nx = vx*vd + ax,       ny = vy*vd + ay,       nz = vz*vd + az;
+
+    v4fStore(v.x + n, v4fSelect(m, nx, vx));
+    v4fStore(v.y + n, v4fSelect(m, ny, vy));
+    v4fStore(v.z + n, v4fSelect(m, nz, vz));
+
+    v4fStore(p.x + n, v4fSelect(m, v4fLoad(p.x + n) + nx*vdt, v4fLoad(p.x + n)));
+    v4fStore(p.y + n, v4fSelect(m, v4fLoad(p.y + n) + ny*vdt, v4fLoad(p.y + n)));
+    v4fStore(p.z + n, v4fSelect(m, v4fLoad(p.z + n) + nz*vdt, v4fLoad(p.z + n)));
+  }
+
+  for(; n < count; ++n)
+  {
+    if(alive && !alive[n])
+      continue;
+
+    v.x[n] = v.x[n]*damping + accel.x*dt;
+    v.y[n] = v.y[n]*damping + accel.y*dt;
+    v.z[n] = v.z[n]*damping + accel.z*dt;
+
+    p.x[n] += v.x[n]*dt;
+    p.y[n] += v.y[n]*dt;
+    p.z[n] += v.z[n]*dt;
+  }
+}
@@ -0,0 +1,16 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void vec3fSoALength(float *out, vec3fSoA v, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+
+  /* squared lengths vectorize; the square roots are one instruction each */
+  vec3fSoADot(out, v, v, count);
+
+  for(n = 0; n < count; ++n)
+    out[n] = sqrtf(out[n]);
+}
@@ -0,0 +1,36 @@
+#include <math.h>
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void vec3fSoANormalize(vec3fSoA v, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t n;
+  int    k;
+
+  for(n = 0; n + 4 <= count; n += 4)
+  {
+    v4f x = v4fLoad(v.x + n), y = v4fLoad(v.y + n), z = v4fLoad(v.z + n);
+    v4f inv = x*x + y*y + z*z;
+
+    for(k = 0; k < 4; ++k)
+      inv[k] = inv[k] > 0.0f ? 1.0f / sqrtf(inv[k]) : 0.0f;
+
+    v4fStore(v.x + n, x*inv);
+    v4fStore(v.y + n, y*inv);
+    v4fStore(v.z + n, z*inv);
+  }
+
+  for(; n < count; ++n)
+  {
+    float inv = v.x[n]*v.x[n] + v.y[n]*v.y[n] + v.z[n]*v.z[n];
+
+    inv = inv > 0.0f ? 1.0f / sqrtf(inv) : 0.0f;
+
+    v.x[n] *= inv;
+    v.y[n] *= inv;
+    v.z[n] *= inv;
+  }
+}
@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void vec3fToOct32Batch(u32 *out, const vec3f *in, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+
+  for(i = 0; i < count; ++i)
+    out[i] = vec3fToOct32(in[i]);
+}
@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void vec3fToVec4fBatch(vec4f *out, const vec3f *in, float w, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+
+  for(i = 0; i < count; ++i)
+    out[i] = vec3fToVec4f(in[i], w);
+}
@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void vec3iCrossBatch(vec3i *out, const vec3i *lhs, const vec3i *rhs, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+
+  for(i = 0; i < count; ++i)
+    out[i] = vec3iCross(lhs[i], rhs[i]);
+}
@@ -0,0 +1,19 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void vec3iScaleBatch(vec3i *out, const vec3i *v, s32 s, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  s32       *o  = &out->x;
+  const s32 *a  = &v->x;
+  v4i       vs = { s, s, s, s };
+  size_t    n  = count*3, i;
+
+  for(i = 0; i + 4 <= n; i += 4)
+    v4iStore(o + i, v4iLoad(a + i) * vs);
+
+  for(; i < n; ++i)
+    o[i] = a[i] * s;
+}
@@ -0,0 +1,19 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+#include "gs_simd.h"
+
+void vec3iSubtractBatch(vec3i *out, const vec3i *lhs, const vec3i *rhs, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  s32       *o = &out->x;
+  const s32 *a = &lhs->x;
+  const s32 *b = &rhs->x;
+  size_t    n = count*3, i;
+
+  for(i = 0; i + 4 <= n; i += 4)
+    v4iStore(o + i, v4iLoad(a + i) - v4iLoad(b + i));
+
+  for(; i < n; ++i)
+    o[i] = a[i] - b[i];
+}
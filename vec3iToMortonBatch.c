@@ -0,0 +1,12 @@
+#include "gs_math.h"
+#include "gs_profile.h"
+
+void vec3iToMortonBatch(u64 *codes, const vec3i *v, size_t count)
+{
+  PROFILE_FUNCTION();
+
+  size_t i;
+
+  for(i = 0; i < count; ++i)
+    codes[i] = vec3iToMorton(v[i]);
+}